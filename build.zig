@@ -3,6 +3,7 @@ const std = @import("std");
 pub fn build(b: *std.Build) void {
     const target = b.standardTargetOptions(.{});
     const mode = b.standardOptimizeOption(.{});
+    const fast = b.option(bool, "fast", "Build zui with ZUI_FAST unchecked accessors") orelse false;
 
     const module = b.addModule("main", .{
         .target = target,
@@ -10,13 +11,19 @@ pub fn build(b: *std.Build) void {
         .link_libc = true,
     });
 
+    // zig fmt: off
+    const common_flags = [_][]const u8{ "-std=c17", "-Wall", "-Wextra", "-Werror", "-pedantic", "-Wshadow",
+        "-Wconversion", "-Wdouble-promotion", "-Wformat=2", "-Wunused-macros", "-Wmissing-prototypes", "-Wstrict-prototypes"};
+    const debug_flags = common_flags ++ [_][]const u8{ "-Og", "-g3", "-fno-omit-frame-pointer", "-fstack-protector-strong", "-DDEBUG"};
+    const bench_flags = common_flags ++ [_][]const u8{ "-O2", "-DNDEBUG"};
+    const fast_flags = bench_flags ++ [_][]const u8{"-DZUI_FAST"};
+    // zig fmt: on
+    const flags: []const []const u8 = if (fast) &fast_flags else &debug_flags;
+    const bench_mode_flags: []const []const u8 = if (fast) &fast_flags else &bench_flags;
+
     module.addCSourceFile(.{
         .file = b.path("src/main.c"),
-        // zig fmt: off
-         .flags = &[_][]const u8{ "-std=c17", "-Wall", "-Wextra", "-Werror", "-pedantic",
-        "-Wshadow", "-Wconversion", "-Wdouble-promotion", "-Wformat=2", "-Wunused-macros", "-Wconversion",
-        "-Og", "-g3", "-fno-omit-frame-pointer", "-fstack-protector-strong", "-DDEBUG", "-Wmissing-prototypes", "-Wmissing-prototypes", "-Wstrict-prototypes"}
-        // zig fmt: on
+        .flags = flags,
     });
 
     module.linkSystemLibrary("raylib", .{});
@@ -41,4 +48,29 @@ pub fn build(b: *std.Build) void {
 
     const run_step = b.step("run", "Run the game");
     run_step.dependOn(&run_cmd.step);
+
+    // Always optimized, -Dfast=true picks the unchecked accessors
+    const bench_module = b.createModule(.{
+        .target = target,
+        .optimize = .ReleaseFast,
+        .link_libc = true,
+    });
+    bench_module.addCSourceFile(.{
+        .file = b.path("src/bench.c"),
+        .flags = bench_mode_flags,
+    });
+    bench_module.linkSystemLibrary("raylib", .{});
+    if (target.result.os.tag == .macos) {
+        bench_module.linkFramework("IOKit", .{});
+        bench_module.linkFramework("Cocoa", .{});
+        bench_module.linkFramework("OpenGL", .{});
+    }
+
+    const bench = b.addExecutable(.{
+        .name = "bench",
+        .root_module = bench_module,
+    });
+    const bench_cmd = b.addRunArtifact(bench);
+    const bench_step = b.step("bench", "Time a 100k-item tree and the layout of a 10k-child row");
+    bench_step.dependOn(&bench_cmd.step);
 }
@@ -0,0 +1,169 @@
+// Frame timings for large trees, run with zig build bench (checked) or zig build bench -Dfast=true
+#define ZUI_IMPLEMENTATION
+#include "zui.h"
+
+#include <stdio.h>
+
+#define BENCH_TREE_ITEMS 100000u
+#define BENCH_TREE_FANOUT 100u
+#define BENCH_ROW_CHILDREN 10000u
+#define BENCH_FRAMES 50u
+
+#ifdef ZUI_FAST
+static const char *benchMode = "fast";
+#else
+static const char *benchMode = "checked";
+#endif
+
+typedef struct BenchTimes
+{
+    double best;
+    double total;
+} BenchTimes;
+
+static uint32_t benchIds[BENCH_TREE_ITEMS];
+static volatile float benchSink;
+
+static void BenchAdd(BenchTimes *times, double start)
+{
+    const double ms = (GetTime() - start) * 1000.0;
+    if (times->total == 0.0 || ms < times->best)
+    {
+        times->best = ms;
+    }
+    times->total += ms;
+}
+
+static void BenchPrint(const char *name, const BenchTimes *times)
+{
+    printf("%-8s %-24s best %8.3f ms  mean %8.3f ms\n", benchMode, name, times->best,
+           times->total / (double)BENCH_FRAMES);
+}
+
+static ZuiConfig BenchConfig(void)
+{
+    ZuiConfig config = ZuiDefaultConfig();
+    config.arenaSize = (size_t)256 << 20;
+    config.itemCapacity = BENCH_TREE_ITEMS + BENCH_TREE_ITEMS / BENCH_TREE_FANOUT;
+    return config;
+}
+
+// 100k labels spread over frames of 99 children each. The lookup pass reads every label's transform through
+// ZuiItemGetComponent, so component lookup stays measured even when ZuiUpdate has nothing to do
+static void BenchTree(void)
+{
+    ZuiConfig config = BenchConfig();
+    if (!ZuiInitEx(&config))
+    {
+        return;
+    }
+
+    uint32_t count = 0;
+    const uint32_t frames = BENCH_TREE_ITEMS / BENCH_TREE_FANOUT;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        ZuiBeginFrame((Rectangle){(float)(f % 40u) * 24.0F, (float)(f / 40u) * 24.0F, 0, 0}, BLANK);
+        for (uint32_t i = 0; i + 1 < BENCH_TREE_FANOUT; i++)
+        {
+            benchIds[count++] = ZuiNewLabel("item");
+        }
+        ZuiEndFrame();
+    }
+
+    BenchTimes lookup = {0};
+    BenchTimes update = {0};
+    BenchTimes render = {0};
+    for (uint32_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        double start = GetTime();
+        float width = 0.0F;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const ZuiTransformData *transform = ZuiItemGetComponent(benchIds[i], ZUI_COMPONENT_TRANSFORM);
+            width += transform ? transform->bounds.width : 0.0F;
+        }
+        benchSink = width;
+        BenchAdd(&lookup, start);
+
+        start = GetTime();
+        ZuiUpdate();
+        BenchAdd(&update, start);
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        start = GetTime();
+        ZuiRender();
+        BenchAdd(&render, start);
+        EndDrawing();
+    }
+
+    printf("%-8s tree: %u labels\n", benchMode, count);
+    BenchPrint("tree lookup", &lookup);
+    BenchPrint("tree update", &update);
+    BenchPrint("tree render", &render);
+    ZuiExit();
+}
+
+// One row with 10k label children. The row is rebuilt every frame to time its first measure and arrange, the
+// last one stays and times the relayout after its first child's text changes
+static void BenchRow(void)
+{
+    ZuiConfig config = BenchConfig();
+    if (!ZuiInitEx(&config))
+    {
+        return;
+    }
+
+    BenchTimes layout = {0};
+    uint32_t first = ZUI_ID_INVALID;
+    for (uint32_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        const uint32_t root = ZuiBeginFrame((Rectangle){0, 0, 0, 0}, BLANK);
+        ZuiBeginRow(2.0F);
+        for (uint32_t i = 0; i < BENCH_ROW_CHILDREN; i++)
+        {
+            const uint32_t id = ZuiNewLabel("item");
+            if (i == 0)
+            {
+                first = id;
+            }
+        }
+
+        const double start = GetTime();
+        ZuiEndRow();
+        BenchAdd(&layout, start);
+        ZuiEndFrame();
+
+        if (frame + 1 < BENCH_FRAMES)
+        {
+            ZuiDestroySubtree(root);
+        }
+    }
+
+    BenchTimes relayout = {0};
+    for (uint32_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        ZuiLabelSetText(first, (frame & 1u) ? "item" : "longer item");
+        const double start = GetTime();
+        ZuiUpdateLayout();
+        BenchAdd(&relayout, start);
+    }
+
+    printf("%-8s row: %u children\n", benchMode, BENCH_ROW_CHILDREN);
+    BenchPrint("row layout", &layout);
+    BenchPrint("row relayout", &relayout);
+    ZuiExit();
+}
+
+int main(void)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(1000, 1000, "ZUI bench");
+
+    BenchRow();
+    BenchTree();
+
+    CloseWindow();
+    return 0;
+}
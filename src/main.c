@@ -1,4 +1,7 @@
+// Build with -Dfast=true for the unchecked ZUI_FAST accessors
+#ifndef ZUI_FAST
 #define ZUI_DEBUG
+#endif
 #ifndef ZUI_IMPLEMENTATION
 #define ZUI_IMPLEMENTATION
 #include "zui.h"
@@ -73,7 +76,7 @@ int main(void)
         ZuiItemSetAlign(l, ZUI_ALIGN_CENTER);
         ZuiSpace(0,8);
 
-        ZuiBeginRow(4);
+        ZuiBeginGrid(4, 4);
             ZuiNewMonoLabel("[7]");
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[8]");
@@ -82,9 +85,6 @@ int main(void)
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[/]");
             ZuiLabelBackgroundColor(tpink);
-        ZuiEndRow() ;
-            
-        ZuiBeginRow(4);
             ZuiNewMonoLabel("[4]");
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[5]");
@@ -93,9 +93,6 @@ int main(void)
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[*]");
             ZuiLabelBackgroundColor(tpink);
-        ZuiEndRow();
-                   
-        ZuiBeginRow(4);
             ZuiNewMonoLabel("[1]");
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[2]");
@@ -104,9 +101,6 @@ int main(void)
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[-]");
             ZuiLabelBackgroundColor(tpink);
-        ZuiEndRow();
-    
-        ZuiBeginRow(4);
             ZuiNewMonoLabel("[0]");
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[.]");
@@ -115,7 +109,7 @@ int main(void)
             ZuiLabelBackgroundColor(tpink);
             ZuiNewMonoLabel("[+]");
             ZuiLabelBackgroundColor(tpink);
-        ZuiEndRow();
+        ZuiEndGrid();
     ZuiEndVertical();    
 
     Texture tex = LoadTexture("src/resources/circle.png");
@@ -149,6 +143,16 @@ int main(void)
 
         ZuiRender();
 
+#ifdef ZUI_FAST
+        const char *mode = "fast";
+#else
+        const char *mode = "checked";
+#endif
+        const ZuiFrameStats stats = ZuiGetFrameStats();
+        DrawText(TextFormat("%s: update %.3f ms, render %.3f ms, %u items", mode, stats.updateMs, stats.renderMs,
+                            stats.itemCount),
+                 16, 976, 10, DARKGRAY);
+
         EndDrawing();
     }
 
@@ -1,6 +1,11 @@
 #ifndef ZUI_H
 #define ZUI_H
 
+// mmap's MAP_ANONYMOUS is hidden under strict -std=c17; must precede the first system include
+#if defined(ZUI_IMPLEMENTATION) && !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 // --- EXTERNAL INCLUDES ---
 #include "math.h"
 #include "raylib.h"
@@ -14,9 +19,39 @@
 #include <stdlib.h>
 #include <string.h>
 #ifdef _WIN32
-
+#if !defined(_WINDOWS_)
+// <windows.h> clashes with raylib (Rectangle, CloseWindow, DrawText), declare only what the arena needs
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    __declspec(dllimport) void *__stdcall VirtualAlloc(void *address, size_t size, unsigned long type, unsigned long protect);
+    __declspec(dllimport) int __stdcall VirtualFree(void *address, size_t size, unsigned long type);
+#ifdef __cplusplus
+}
+#endif
+#endif
+#define ZUI_HAS_VIRTUAL_MEMORY 1
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(MAP_ANONYMOUS) || defined(MAP_ANON)
+#define ZUI_HAS_VIRTUAL_MEMORY 1
 #else
+#define ZUI_HAS_VIRTUAL_MEMORY 0
+#endif
+#endif
 
+// Batch hit testing uses the widest vector unit the compiler targets, ZUI_NO_SIMD forces scalar
+#if !defined(ZUI_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define ZUI_SIMD_AVX 1
+#elif !defined(ZUI_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define ZUI_SIMD_SSE 1
+#elif !defined(ZUI_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ZUI_SIMD_NEON 1
 #endif
 
 #ifdef __cplusplus
@@ -30,7 +65,12 @@ extern "C"
     // Lifecycle: Create once, modify per frame, destroy t exit. Do not create every frame.
     // Do not store pointers to UI data across frames. Use IDs.
 
-#ifndef ZUI_DEBUG
+    // ZUI_FAST swaps the hot accessors for unchecked inline versions, ZUI_DEBUG keeps them checked
+#if defined(ZUI_FAST) && defined(ZUI_DEBUG)
+#undef ZUI_FAST
+#endif
+
+#if !defined(ZUI_DEBUG) && !defined(ZUI_FAST)
 #define ZUI_DEBUG
 #endif
 
@@ -62,6 +102,41 @@ extern "C"
 #define ZUI_MAX_DYNARRAY_CAPACITY 1048576u /* 1M items max */
 #endif
 
+#ifndef ZUI_GRID_MAX_TRACKS
+#define ZUI_GRID_MAX_TRACKS 8u /* explicit columns or rows per grid */
+#endif
+
+#ifndef ZUI_GRID_MAX_SPAN
+#define ZUI_GRID_MAX_SPAN 256u /* columns or rows one grid child may cover */
+#endif
+
+// Item ids pack a slot index (low bits) and a generation (high bits)
+#define ZUI_ID_INDEX_BITS 20u
+#define ZUI_ID_INDEX_MASK ((1u << ZUI_ID_INDEX_BITS) - 1u)
+#define ZUI_ID_GENERATION_MASK (UINT32_MAX >> ZUI_ID_INDEX_BITS)
+
+#ifndef ZUI_ARENA_RESERVE_SIZE
+#if SIZE_MAX > 0xFFFFFFFFu
+#define ZUI_ARENA_RESERVE_SIZE ((size_t)1 << 32) /* 4GB of address space, committed on demand */
+#else
+#define ZUI_ARENA_RESERVE_SIZE ((size_t)1 << 28) /* 256MB on 32-bit targets */
+#endif
+#endif
+
+#ifndef ZUI_HEAP_ARENA_SCALE
+#define ZUI_HEAP_ARENA_SCALE 4u /* heap arenas cannot grow, they take this many times their initial size up front */
+#endif
+
+#ifndef ZUI_ARENA_SIZE_CLASSES
+#define ZUI_ARENA_SIZE_CLASSES 27 /* free list classes 16B .. 1GB */
+#endif
+
+#ifndef ZUI_ARENA_MAX_TYPE_STATS
+#define ZUI_ARENA_MAX_TYPE_STATS 32
+#endif
+
+#define ZUI_ARENA_MIN_BLOCK_SHIFT 4
+
     ///-----------------------------------------------------------ZUI_REPORT_ERROR
 
 #ifdef ZUI_DEBUG
@@ -130,10 +205,12 @@ extern "C"
 
     typedef enum ZuiConstants
     {
-        ZUI_COMPONENT_TYPES = 12,
-        ZUI_CHILDREN_CAPACITY = 2,
+        ZUI_ITEM_COMPONENTS_MAX = 12, // components attached to a single item
+        ZUI_COMPONENT_MASK_BITS = 32, // component ids below this get a componentMask bit and can be queried
         ZUI_ALIGNMENT_MAX_ITEMS = 8,
-        ZUI_MAX_TEXT_LENGTH = 64,
+        ZUI_STRINGS_CAPACITY = 32,
+        ZUI_STRING_BYTES_CAPACITY = 512,
+        ZUI_STRING_BUCKETS = 64, // power of two
         ZUI_MAX_WINDOWS = 8,
         ZUI_BASE_FONT_SIZE = 18,
         ZUI_TITLEBAR_HEIGHT = 28,
@@ -152,11 +229,11 @@ extern "C"
         ZUI_MAX_FOCUSABLE_WIDGETS = 8,
         ZUI_ROUNDNESS_SEGMENTS = 16,
         ZUI_DEFAULT_ARENA_SIZE = 1048576, // 1MB =1048576
+        ZUI_FRAME_ARENA_SIZE = 262144,    // 256KB, per-frame scratch
         ZUI_DEFAULT_SCREEN_WIDTH = 800,
         ZUI_DEFAULT_SCREEN_HEIGHT = 600,
         ZUI_DEFAULT_DPI_SCALE = 1,
         ZUI_ROOT_FRAME_ID = 0,
-        ZUI_MAX_TREE_DEPTH = 64,
     } ZuiConstants;
 
     static const float ZUI_FONT_SPACING = 0.2F;
@@ -164,6 +241,7 @@ extern "C"
     static const float ZUI_DEFAULT_FRAME_GAP = 4.0F;
     static const float ZUI_CORNER_RADIUS = 8.0F;
     static const float MIN_BUTTON_SIZE = 24.0F;
+    static const float ZUI_WRAP_TOLERANCE = 0.01F; // absorbs rounding when a line fills the width exactly
     static const uint32_t ZUI_ID_INVALID = UINT_MAX;
 
     typedef enum ZuiItemType
@@ -194,14 +272,46 @@ extern "C"
     // -----------------------------------------------------------------------------
     // zui_arena.h
 
+    typedef struct ZuiArenaTypeStats
+    {
+        const char *typeName;
+        size_t releasedBytes;  // returned to the free lists
+        size_t reclaimedBytes; // served from the free lists
+        size_t wastedBytes;    // released but too small or misaligned to recycle
+    } ZuiArenaTypeStats;
+
+    // Host-provided heap, sizes are passed back so budgeted allocators need no headers. Arenas take their
+    // whole capacity in one allocation and never reallocate it, pointers into them stay valid
+    typedef struct ZuiAllocator
+    {
+        void *(*alloc)(size_t size, void *user);
+        void (*free)(void *ptr, size_t size, void *user);
+        void *user;
+    } ZuiAllocator;
+
     typedef struct ZuiArena
     {
         unsigned char *buffer;
         size_t offset;
-        size_t capacity;
+        size_t capacity; // usable bytes (committed bytes for virtual arenas)
         size_t initialCapacity;
+        size_t reserved; // reserved address space, 0 for heap arenas
+        bool isVirtual;  // reserve/commit arena that commits on demand, heap arenas are fixed size
+        size_t highWater; // peak offset, survives ZuiResetArena
+        size_t freeLists[ZUI_ARENA_SIZE_CLASSES]; // head block offset + 1, 0 when empty
+        size_t freeBytes;
+        ZuiArenaTypeStats typeStats[ZUI_ARENA_MAX_TYPE_STATS];
+        uint32_t typeStatsCount;
+        bool recycleSuspended; // free lists are neither fed nor drained while set
+        float growthFactor;    // capacity multiplier for dynarrays grown from this arena, 0 means 2
+        ZuiAllocator allocator; // backs heap arenas, unused by virtual ones
     } ZuiArena;
 
+    typedef struct ZuiArenaMarker
+    {
+        size_t offset;
+    } ZuiArenaMarker;
+
     typedef struct ZuiArenaStats
     {
         size_t totalCapacity;
@@ -210,6 +320,10 @@ extern "C"
         float usagePercent;
         size_t initialCapacity;
         size_t maxCapacity;
+        size_t reservedBytes;
+        size_t committedBytes;
+        size_t highWaterBytes;
+        size_t freeBytes;
     } ZuiArenaStats;
 
 #define ZUI_ARENA_ALLOC(arena, size) \
@@ -221,13 +335,45 @@ extern "C"
 #define ZUI_ARENA_ALLOC_ARRAY(arena, type, count) \
     ((type *)ZuiAllocArena(arena, sizeof(type) * (count), ZUI_ALIGNOF(type)))
 
+    ZuiAllocator ZuiDefaultAllocator(void);
     ZuiResult ZuiInitArena(ZuiArena *arena, size_t capacity);
+    ZuiResult ZuiInitArenaEx(ZuiArena *arena, size_t capacity, const ZuiAllocator *allocator);
+    ZuiResult ZuiInitArenaVirtual(ZuiArena *arena, size_t reserveSize, size_t initialCommit);
     void ZuiUnloadArena(ZuiArena *arena);
     void ZuiResetArena(ZuiArena *arena);
+    ZuiResult ZuiGrowArena(ZuiArena *arena, size_t requiredSize);
+#ifdef ZUI_FAST
+    // Bump allocation without validation, alignment must be a power of two. The address is aligned rather than
+    // the offset, heap buffers only come with malloc's alignment
+    static inline void *ZuiAllocArena(ZuiArena *arena, const size_t size, const size_t alignment)
+    {
+        const uintptr_t base = (uintptr_t)(arena->buffer + arena->offset);
+        const size_t offset = arena->offset + (size_t)((0 - base) & (alignment - 1));
+        if (offset + size > arena->capacity && ZuiGrowArena(arena, offset + size) != ZUI_OK)
+        {
+            return NULL;
+        }
+
+        void *ptr = arena->buffer + offset;
+        arena->offset = offset + size;
+        if (arena->offset > arena->highWater)
+        {
+            arena->highWater = arena->offset;
+        }
+        memset(ptr, 0, size);
+        return ptr;
+    }
+#else
     void *ZuiAllocArena(ZuiArena *arena, size_t size, size_t alignment);
+#endif
     void *ZuiAllocArenaDefault(ZuiArena *arena, size_t size);
     ZuiArenaStats ZuiGetArenaStats(const ZuiArena *arena);
-    ZuiResult ZuiGrowArena(ZuiArena *arena, size_t requiredSize);
+    void *ZuiAllocArenaBlock(ZuiArena *arena, size_t size, size_t alignment, const char *typeName,
+                             size_t *blockSize);
+    void ZuiFreeArenaBlock(ZuiArena *arena, void *ptr, size_t size, const char *typeName);
+    ZuiArenaTypeStats ZuiGetArenaTypeStats(const ZuiArena *arena, const char *typeName);
+    ZuiArenaMarker ZuiArenaMark(const ZuiArena *arena);
+    void ZuiArenaRestore(ZuiArena *arena, ZuiArenaMarker marker);
 
     // -----------------------------------------------------------------------------
     // zui_dynarray.h
@@ -261,12 +407,119 @@ extern "C"
     ZuiResult ZuiInitDynArray(ZuiDynArray *array, ZuiArena *arena, uint32_t initialCapacity,
                               size_t itemSize, size_t itemAlignment, const char *typeName);
     ZuiResult ZuiGrowDynArray(ZuiDynArray *array, ZuiArena *arena);
+#ifdef ZUI_FAST
+    // Growth still validates, an uninitialized array fails there and yields NULL
+    static inline void *ZuiPushDynArray(ZuiDynArray *array, ZuiArena *arena)
+    {
+        if (array->count >= array->capacity && ZuiGrowDynArray(array, arena) != ZUI_OK)
+        {
+            return NULL;
+        }
+        return (char *)array->items + (array->itemSize * array->count++);
+    }
+
+    // Unchecked, index must be below count
+    static inline void *ZuiGetDynArray(const ZuiDynArray *array, const uint32_t index)
+    {
+        return (char *)array->items + (array->itemSize * index);
+    }
+#else
     void *ZuiPushDynArray(ZuiDynArray *array, ZuiArena *arena);
     void *ZuiGetDynArray(const ZuiDynArray *array, uint32_t index);
+#endif
     void ZuiClearDynArray(ZuiDynArray *array);
     bool ZuiIsDynArrayValid(const ZuiDynArray *array);
     ZuiDynArrayStats ZuiGetDynArrayStats(const ZuiDynArray *array);
 
+    ///-------------------------------------Paged Array
+
+#define ZUI_PAGE_SHIFT 6u
+#define ZUI_PAGE_SIZE (1u << ZUI_PAGE_SHIFT) // entries per page
+#define ZUI_PAGE_MASK (ZUI_PAGE_SIZE - 1u)
+
+    // Fixed-size pages that never move, growth appends a page and only the page table is copied
+    typedef struct ZuiPagedArray
+    {
+        ZuiDynArray pages; // void * per page
+        uint32_t count;
+        size_t itemSize;
+        size_t itemAlignment;
+        const char *typeName;
+    } ZuiPagedArray;
+
+    ZuiResult ZuiInitPagedArray(ZuiPagedArray *array, ZuiArena *arena, uint32_t initialCapacity,
+                                size_t itemSize, size_t itemAlignment, const char *typeName);
+    void *ZuiPushPagedArray(ZuiPagedArray *array, ZuiArena *arena);
+    void *ZuiGetPagedArray(const ZuiPagedArray *array, uint32_t index);
+    void ZuiSwapRemovePagedArray(ZuiPagedArray *array, uint32_t index);
+    uint32_t ZuiGetPagedArrayCapacity(const ZuiPagedArray *array);
+
+    ///-------------------------------------Typed accessors
+
+    // ZUI_DEFINE_ARRAY(T) emits inline accessors with sizeof(T) as the stride:
+    //   TArrayAt/TArrayGet/TArrayPush over a ZuiDynArray of T, TPageAt/TPageGet over a ZuiPagedArray of T.
+    // At skips the bounds check, Get returns NULL past count. Invoke without a trailing semicolon.
+#define ZUI_DEFINE_ARRAY(type)                                                                 \
+    static inline type *type##ArrayAt(const ZuiDynArray *array, const uint32_t index)         \
+    {                                                                                          \
+        return (type *)array->items + index;                                                   \
+    }                                                                                          \
+    static inline type *type##ArrayGet(const ZuiDynArray *array, const uint32_t index)        \
+    {                                                                                          \
+        return index < array->count ? (type *)array->items + index : NULL;                     \
+    }                                                                                          \
+    static inline type *type##ArrayPush(ZuiDynArray *array, ZuiArena *arena)                   \
+    {                                                                                          \
+        if (array->count < array->capacity)                                                    \
+        {                                                                                      \
+            return (type *)array->items + array->count++;                                      \
+        }                                                                                      \
+        return (type *)ZuiPushDynArray(array, arena);                                          \
+    }                                                                                          \
+    static inline type *type##PageAt(const ZuiPagedArray *array, const uint32_t index)        \
+    {                                                                                          \
+        return (type *)((void *const *)array->pages.items)[index >> ZUI_PAGE_SHIFT] +         \
+               (index & ZUI_PAGE_MASK);                                                        \
+    }                                                                                          \
+    static inline type *type##PageGet(const ZuiPagedArray *array, const uint32_t index)       \
+    {                                                                                          \
+        return index < array->count ? type##PageAt(array, index) : NULL;                       \
+    }
+
+    // -----------------------------------------------------------------------------
+    // zui_string.h
+
+#define ZUI_STRING_NONE 0u
+#define ZUI_STRING_TOMBSTONE UINT32_MAX // bucket of a released string, probes continue past it
+
+    typedef struct ZuiStringEntry
+    {
+        size_t offset; // into the byte array
+        uint32_t length;
+        uint32_t hash;
+        uint32_t refs;     // 0 once released, the entry then waits on the free list
+        uint32_t nextFree; // handle of the next released entry
+    } ZuiStringEntry;
+
+    // Deduplicated, reference counted text, a handle is entry index + 1 and stays valid until its last release
+    typedef struct ZuiStringPool
+    {
+        ZuiDynArray bytes;   // NUL-terminated strings back to back
+        ZuiDynArray entries; // ZuiStringEntry
+        ZuiDynArray buckets; // open-addressed handles, count is the table size
+        uint32_t occupied;   // buckets holding a handle or a tombstone
+        uint32_t freeHead;   // first released entry, reused before the array grows
+        size_t deadBytes;    // bytes of released strings, reclaimed by repacking
+        bool frozen;         // set while a transient scope can roll the pool back, nothing is released or reused
+    } ZuiStringPool;
+
+    ZuiResult ZuiInitStringPool(ZuiStringPool *pool, ZuiArena *arena);
+    // Takes a reference on the returned handle, give it back with ZuiReleaseString
+    uint32_t ZuiInternString(ZuiStringPool *pool, ZuiArena *arena, const char *text);
+    void ZuiReleaseString(ZuiStringPool *pool, uint32_t handle);
+    const char *ZuiGetPooledString(const ZuiStringPool *pool, uint32_t handle);
+    uint32_t ZuiGetPooledStringLength(const ZuiStringPool *pool, uint32_t handle);
+
     // -----------------------------------------------------------------------------
     // zui_component.h
 
@@ -309,10 +562,12 @@ extern "C"
         ZUI_COMPONENT_SCROLL,
         ZUI_COMPONENT_LAYER,
         ZUI_COMPONENT_SPATIAL,
+        ZUI_COMPONENT_GRID,
         ZUI_COMPONENT_COUNT,
     } ZuiComponentId;
 
     typedef void (*ZuiComponentInitFunc)(void *data, uint32_t itemId, ZuiComponentId componentId);
+    typedef void (*ZuiComponentUpdateFunc)(void *data, uint32_t itemId);
 
     typedef struct ZuiComponentRegistration
     {
@@ -320,16 +575,22 @@ extern "C"
         size_t dataSize;
         size_t dataAlignment;
         uint32_t initialCapacity;
-        ZuiDynArray dataArray;
+        ZuiPagedArray dataArray; // packed between walks, pointers stay valid until a removal is compacted
+        ZuiDynArray sparse;      // item slot index -> data index + 1, 0 when absent
+        ZuiDynArray owners;      // data index -> owning item id
         uint32_t id;
         ZuiComponentInitFunc init;
+        ZuiComponentUpdateFunc update; // optional per-frame system, run over the dense data
         const uint32_t *requiredComponents;
         uint32_t requiredComponentCount;
     } ZuiComponentRegistration;
 
+    ZUI_DEFINE_ARRAY(ZuiComponentRegistration)
+
+    // Built-in ids come first, custom components are appended after ZUI_COMPONENT_COUNT
     typedef struct ZuiComponentRegistry
     {
-        ZuiComponentRegistration registrations[ZUI_COMPONENT_TYPES];
+        ZuiPagedArray registrations; // ZuiComponentRegistration, paged so pointers survive growth
         uint32_t registeredCount;
     } ZuiComponentRegistry;
 
@@ -346,8 +607,12 @@ extern "C"
     typedef struct ZuiTransformData
     {
         uint32_t itemId;
-        Rectangle bounds;
+        Rectangle bounds; // position relative to the nearest transformed ancestor's origin
         Vector2 offset;
+        Rectangle worldBounds; // cached ZuiGetTransformBounds result, on screen
+        Vector2 worldOrigin;   // layout position of bounds + offset, children are placed from here
+        Vector2 scrollShift;   // scroll offsets of the ancestors and this item, subtracted from the children on screen
+        bool worldValid;
     } ZuiTransformData;
 
     //--------------------------- LAYOUT COMPONENT
@@ -357,6 +622,8 @@ extern "C"
         ZUI_LAYOUT_NONE = 0,
         ZUI_LAYOUT_VERTICAL,
         ZUI_LAYOUT_HORIZONTAL,
+        ZUI_LAYOUT_WRAP, // left to right, breaking lines at the container width
+        ZUI_LAYOUT_GRID, // children fill column/row cells in order
     } ZuiLayoutKind;
 
     typedef enum ZuiSizeMode
@@ -366,6 +633,13 @@ extern "C"
         ZUI_SIZE_FILL,  // Fill available space
     } ZuiSizeMode;
 
+    // One grid column or row, FIXED sizes are pixels and FILL sizes are weights of the space left over
+    typedef struct ZuiGridTrack
+    {
+        ZuiSizeMode mode;
+        float size;
+    } ZuiGridTrack;
+
     typedef enum ZuiAlign
     {
         ZUI_ALIGN_START,  // Left/Top
@@ -382,9 +656,24 @@ extern "C"
         ZuiAlign childAlign; // How children align in cross-axis
         float measuredWidth;
         float measuredHeight;
-        bool isFinalized;
+        bool isFinalized;  // arranged at least once, later changes go through the layout queue
+        bool needsArrange; // queued, or on the path of a queued change
+        bool hugWidth;     // a top-level layout opened with zero size keeps following its measure
+        bool hugHeight;
+        uint32_t measurePass; // layout pass that produced the child records at measureOffset
+        size_t measureOffset; // frame arena offset of childCount ZuiMeasureEntry records
     } ZuiLayoutData;
 
+    // Explicit tracks of a grid layout, kept apart so other layouts do not carry them
+    typedef struct ZuiGridData
+    {
+        uint32_t itemId;
+        ZuiGridTrack columns[ZUI_GRID_MAX_TRACKS]; // no columns is a single auto column
+        ZuiGridTrack rows[ZUI_GRID_MAX_TRACKS];    // rows past rowCount are auto
+        uint32_t columnCount;
+        uint32_t rowCount;
+    } ZuiGridData;
+
     typedef struct ZuiAlignData
     {
         uint32_t itemId;
@@ -394,8 +683,24 @@ extern "C"
         float fixedWidth;
         float fixedHeight;
         float margin; // Uniform margin on all sides
+        uint32_t columnSpan; // Grid cells covered, 0 counts as 1
+        uint32_t rowSpan;
     } ZuiAlignData;
 
+    // Per-child result of a measure pass, consumed by arrange in the same pass
+    typedef struct ZuiMeasureEntry
+    {
+        Vector2 size;
+        float margin;
+        ZuiAlign align; // the child's own alignment, START defers to the layout
+        bool fillWidth;
+        bool fillHeight;
+        uint32_t columnSpan; // at least 1
+        uint32_t rowSpan;
+        uint32_t column; // grid cell, placed while measuring
+        uint32_t row;
+    } ZuiMeasureEntry;
+
     //--------------------------- ANIMATION COMPONENT
 
     typedef enum ZuiAnimationType
@@ -633,16 +938,21 @@ extern "C"
         size_t dataSize;
         size_t dataAlignment;
         uint32_t initialCapacity;
-        ZuiDynArray dataArray;
+        ZuiPagedArray dataArray; // pointers into it stay valid for the item's lifetime
+        ZuiDynArray freeSlots;   // data indices released by destroyed items
         uint32_t id;
         ZuiTypeInitFunc init;
-        ZuiUpdateFunction update;
+        ZuiUpdateFunction update; // runs for items marked with ZuiMarkDirty, unless alwaysUpdate is set
         ZuiRenderFunction render;
+        bool alwaysUpdate; // items keep themselves dirty, for types that poll input or time every frame
     } ZuiTypeRegistration;
 
+    ZUI_DEFINE_ARRAY(ZuiTypeRegistration)
+
+    // Built-in ids come first, custom widget types are appended after ZUI_TYPE_COUNT
     typedef struct ZuiTypeRegistry
     {
-        ZuiTypeRegistration registrations[16];
+        ZuiPagedArray registrations; // ZuiTypeRegistration, paged so pointers survive growth
         uint32_t registeredCount;
     } ZuiTypeRegistry;
 
@@ -650,16 +960,48 @@ extern "C"
 
     ZuiResult ZuiInitComponentRegistry(void);
     ZuiResult ZuiRegisterComponent(ZuiComponentId componentId, const ZuiComponentRegistration *info);
+    uint32_t ZuiRegisterCustomComponent(const ZuiComponentRegistration *info);
     void ZuiRegisterAllComponents(void);
     void *ZuiEnsureComponent(uint32_t itemId, ZuiComponentId componentId);
     Vector2 ZuiGetAbsolutePosition(uint32_t itemId);
     void *ZuiItemAddComponent(uint32_t itemId, uint32_t componentId);
     void *ZuiItemGetComponent(uint32_t itemId, uint32_t componentId);
+    ZuiResult ZuiItemRemoveComponent(uint32_t itemId, uint32_t componentId);
     bool ZuiItemHasComponent(uint32_t itemId, uint32_t componentId);
     bool ZuiValidateComponentDependencies(uint32_t itemId, uint32_t componentId);
     ZuiComponentRegistration *ZuiGetComponentRegistration(uint32_t componentId);
     const ZuiComponentRegistration *ZuiGetComponentInfo(uint32_t componentId);
 
+    //---------------------------  QUERY API
+
+#define ZUI_COMPONENT_BIT(componentId) ((uint32_t)1U << (uint32_t)(componentId))
+
+    // Walks the dense data of the rarest component in mask, components[] holds the match's data. While a query
+    // is open, removed components leave holes that are compacted once the last open query ends, so removing or
+    // destroying anything mid-walk neither skips nor repeats a match
+    typedef struct ZuiQuery
+    {
+        uint32_t mask;
+        uint32_t driver; // component whose dense array is walked
+        uint32_t cursor; // next dense index
+        uint32_t index;  // dense index of the current match in the driver's array
+        uint32_t itemId;
+        void *components[ZUI_COMPONENT_MASK_BITS];
+        bool open; // closed by the ZuiQueryNext that returns false, or by ZuiQueryEnd
+    } ZuiQuery;
+
+    // A component data slot whose swap-remove waits for the running walks to finish
+    typedef struct ZuiDeferredRemoval
+    {
+        uint32_t componentId;
+        uint32_t dataIndex;
+    } ZuiDeferredRemoval;
+
+    ZuiQuery ZuiQueryBegin(uint32_t mask);
+    bool ZuiQueryNext(ZuiQuery *query);
+    // Only needed when leaving a query loop early
+    void ZuiQueryEnd(ZuiQuery *query);
+
     //---------------------------  TRANSFORM API
 
     uint32_t ZuiCreateTransform(uint32_t itemId, Rectangle bounds);
@@ -668,6 +1010,32 @@ extern "C"
     void ZuiSetTransformBoundsPosition(uint32_t itemId, Vector2 offset);
     Rectangle ZuiGetTransformBounds(uint32_t itemId);
 
+    // World bounds split into 32-byte aligned lanes, padded to a multiple of 8 with empty rects. The kernel uses
+    // unaligned loads, so a lane that lost its alignment is slower but never faults
+    typedef struct ZuiBoundsSoA
+    {
+        float *x;
+        float *y;
+        float *width;
+        float *height;
+        uint32_t count; // padded lane count
+    } ZuiBoundsSoA;
+
+    // World bounds of every item slot, kept in step with the transform caches for batch hit tests
+    typedef struct ZuiWorldLanes
+    {
+        ZuiBoundsSoA bounds;  // by item slot index
+        uint32_t *ids;        // item each lane was written for
+        ZuiDynArray stale;    // items whose world bounds were invalidated since the last refresh
+        bool rebuild;         // rewrite every lane, after growth, a failed push or a transient scope rollback
+        uint32_t failedCount; // item count the last growth failed at, not retried until there are more items
+    } ZuiWorldLanes;
+
+    ZuiResult ZuiInitBoundsSoA(ZuiBoundsSoA *soa, ZuiArena *arena, uint32_t count);
+    void ZuiSetBoundsSoA(ZuiBoundsSoA *soa, uint32_t index, Rectangle bounds);
+    void ZuiHitTestBatch(const ZuiBoundsSoA *soa, Vector2 point, uint8_t *hitMasks);
+    bool ZuiBoundsSoAHit(const uint8_t *hitMasks, uint32_t index);
+
     //---------------------------  LAYOUT API
 
     ZuiAlignData *ZuiGetOrCreateAlignData(uint32_t itemId);
@@ -680,17 +1048,27 @@ extern "C"
     void ZuiItemSetSizeMode(uint32_t itemId, ZuiSizeMode widthMode, ZuiSizeMode heightMode);
     void ZuiItemSetFixedSize(uint32_t itemId, float width, float height);
     void ZuiItemSetMargin(uint32_t itemId, float margin);
+    void ZuiItemSetGridSpan(uint32_t itemId, uint32_t columnSpan, uint32_t rowSpan);
+    void ZuiItemSpanLast(uint32_t columnSpan, uint32_t rowSpan);
+    ZuiResult ZuiGridSetColumns(uint32_t itemId, const ZuiGridTrack *tracks, uint32_t count);
+    ZuiResult ZuiGridSetRows(uint32_t itemId, const ZuiGridTrack *tracks, uint32_t count);
     uint32_t ZuiBeginVertical(Vector2 pos, float spacing, Color color);
     uint32_t ZuiBeginHorizontal(Vector2 pos, float spacing, Color color);
     void ZuiEndLayout(void);
+    void ZuiInvalidateLayout(uint32_t itemId);
+    void ZuiUpdateLayout(void);
     uint32_t ZuiBeginRow(float spacing);
     uint32_t ZuiBeginColumn(float spacing);
     uint32_t ZuiBeginCentered(float spacing, Color color);
-    void ZuiMeasureRecursive(uint32_t itemId, int depth);
-    void ZuiArrangeRecursive(uint32_t itemId, Rectangle bounds, int depth);
+    uint32_t ZuiBeginWrap(float width, float spacing);
+    uint32_t ZuiBeginGrid(uint32_t columns, float spacing);
+    void ZuiMeasureTree(uint32_t itemId);
+    void ZuiArrangeTree(uint32_t itemId, Rectangle bounds);
     void ZuiSpace(float x, float y);
     void ZuiEndRow(void);
     void ZuiEndColumn(void);
+    void ZuiEndWrap(void);
+    void ZuiEndGrid(void);
     void ZuiEndVertical(void);
     void ZuiEndHorizontal(void);
     void ZuiEndFrameAuto(void);
@@ -750,7 +1128,7 @@ extern "C"
 
     //---------------------------  SCROLL API
 
-    void ZuiApplyScrollOffsetRecursive(uint32_t itemId, Vector2 offset);
+    void ZuiApplyScrollOffset(uint32_t itemId, Vector2 offset);
     void ZuiEnableScroll(uint32_t frameId, bool vertical, bool horizontal);
     Rectangle ZuiGetChildContentBounds(uint32_t childId);
     Vector2 ZuiCalculateContentSize(uint32_t itemId);
@@ -778,14 +1156,16 @@ extern "C"
 
     //---------------------------  TYPES
 
-    ZuiResult ZuiInitRegistryEntry(ZuiDynArray *dataArray, ZuiTypeRegistration *entry, uint32_t id,
+    ZuiResult ZuiInitRegistryEntry(ZuiPagedArray *dataArray, ZuiTypeRegistration *entry, uint32_t id,
                                    const char *name, size_t dataSize,
                                    size_t dataAlignment, uint32_t capacity);
-    void *ZuiGetRegistryData(ZuiDynArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex);
-    const void *ZuiGetRegistryDataConst(ZuiDynArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex);
-    void *ZuiAllocRegistryData(ZuiDynArray *dataArray, ZuiTypeRegistration *entry);
+    void *ZuiGetRegistryData(ZuiPagedArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex);
+    const void *ZuiGetRegistryDataConst(ZuiPagedArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex);
+    void *ZuiAllocRegistryData(ZuiPagedArray *dataArray, ZuiTypeRegistration *entry);
     void ZuiRegisterAllTypes(void);
+    ZuiResult ZuiInitTypeRegistry(void);
     ZuiResult ZuiRegisterType(ZuiItemType typeId, const ZuiTypeRegistration *info);
+    uint32_t ZuiRegisterCustomType(const ZuiTypeRegistration *info);
     const ZuiTypeRegistration *ZuiGetTypeInfo(uint32_t typeId);
     bool ZuiIsValidTypeId(uint32_t typeId);
     ZuiTypeRegistration *ZuiGetTypeRegistration(uint32_t typeId);
@@ -796,25 +1176,59 @@ extern "C"
     // -----------------------------------------------------------------------------
     // zui_item.h
 
+    typedef enum ZuiDirtyFlags
+    {
+        ZUI_DIRTY_SELF = 1 << 0,     // the item's own update must run
+        ZUI_DIRTY_CHILDREN = 1 << 1, // some descendant is dirty
+    } ZuiDirtyFlags;
+
     typedef struct ZuiItem
     {
-        ZuiDynArray children; // costs 32kb per 1k items, 800 leaf, 200 container
         uint32_t type;
         uint32_t id;
         uint32_t parentId;
+        uint32_t firstChild; // intrusive child list, ZUI_ID_INVALID when empty
+        uint32_t lastChild;
+        uint32_t nextSibling;
+        uint32_t prevSibling;
+        uint32_t childCount;
         uint32_t dataIndex;
         uint32_t componentMask;
-        ZuiItemComponent components[ZUI_COMPONENT_TYPES];
+        ZuiItemComponent components[ZUI_ITEM_COMPONENTS_MAX];
         uint32_t componentCount;
+        uint32_t generation; // bumped each time the slot is reused
         bool isContainer;
         bool canMove;
+        uint8_t dirtyFlags; // ZuiDirtyFlags, cleared when ZuiUpdateItem visits the item
     } ZuiItem;
 
+    // One pending item of a tree walk, walks run on an explicit stack instead of recursion
+    typedef struct ZuiWalkEntry
+    {
+        uint32_t id;
+        uint32_t parent; // stack index of the entry that pushed this one, ZUI_ID_INVALID when unused
+        bool expanded;   // post-order, children were pushed and the next pop visits the item
+        Rectangle rect;  // per-walk payload
+    } ZuiWalkEntry;
+
+    ZUI_DEFINE_ARRAY(ZuiItem)
+
+#ifndef ZUI_FAST
     const ZuiItem *ZuiGetItem(uint32_t id);
+#endif
     ZuiItem *ZuiGetItemMut(uint32_t id);
+    uint32_t ZuiItemIdIndex(uint32_t id);
+    uint32_t ZuiItemIdGeneration(uint32_t id);
+    bool ZuiIsItemAlive(uint32_t id);
     uint32_t ZuiCreateItem(ZuiItemType type, uint32_t dataIndex);
+    ZuiResult ZuiDestroyItem(uint32_t id);
+    ZuiResult ZuiDestroySubtree(uint32_t id);
     ZuiResult ZuiItemAddChild(uint32_t parentId, uint32_t childId);
+    ZuiResult ZuiItemRemoveChild(uint32_t parentId, uint32_t childId);
+    uint32_t ZuiItemFirstChild(uint32_t id);
+    uint32_t ZuiItemNextSibling(uint32_t id);
     uint32_t ZuiAddChild(uint32_t id);
+    void ZuiMarkDirty(uint32_t id);
     void ZuiUpdateItem(const ZuiItem *item);
     void ZuiRenderItem(const ZuiItem *item);
     // -----------------------------------------------------------------------------
@@ -838,6 +1252,8 @@ extern "C"
         bool enableScissor;
     } ZuiFrameData;
 
+    ZUI_DEFINE_ARRAY(ZuiFrameData)
+
     uint32_t ZuiCreateFrame(Rectangle bounds, ZuiFrameStyle style);
     uint32_t ZuiBeginFrame(Rectangle bounds, Color color);
     void ZuiEndFrame(void);
@@ -850,7 +1266,6 @@ extern "C"
     void ZuiFrameCornerRadius(float radius);
     void ZuiFrameEnableScissor(uint32_t itemId, bool enable);
     void ZuiFrameMakeScrollable(bool vertical, bool horizontal);
-    void ZuiUpdateFrame(uint32_t dataIndex);
     void ZuiRenderFrame(uint32_t dataIndex);
     float ZuiGetFramePadding(uint32_t itemId);
     float ZuiGetFrameSpacing(uint32_t itemId);
@@ -870,10 +1285,12 @@ extern "C"
     typedef struct ZuiLabelData
     {
         ZuiLabelStyle style;
-        char text[ZUI_MAX_TEXT_LENGTH + 1];
+        uint32_t text; // string pool handle
         uint32_t itemId;
     } ZuiLabelData;
 
+    ZUI_DEFINE_ARRAY(ZuiLabelData)
+
     uint32_t ZuiCreateLabel(const char *text, ZuiLabelStyle style);
     uint32_t ZuiAddLabelToFrame(uint32_t id);
     uint32_t ZuiNewLabel(const char *text);
@@ -881,6 +1298,8 @@ extern "C"
     void ZuiLabelTextColor(Color textColor);
     void ZuiLabelBackgroundColor(Color backgroundColor);
     void ZuiLabelOffset(float x, float y);
+    ZuiResult ZuiLabelSetText(uint32_t itemId, const char *text);
+    const char *ZuiLabelGetText(uint32_t itemId);
     void ZuiRenderLabel(uint32_t dataIndex);
 
     // -----------------------------------------------------------------------------
@@ -899,6 +1318,8 @@ extern "C"
         uint32_t itemId;
     } ZuiTextureData;
 
+    ZUI_DEFINE_ARRAY(ZuiTextureData)
+
     uint32_t ZuiCreateTexture(Texture2D texture, ZuiTextureStyle style);
     void ZuiRenderTexture(uint32_t dataIndex);
     uint32_t ZuiNewTextureEx(Texture2D tex, NPatchInfo npatch, Rectangle bounds);
@@ -952,6 +1373,8 @@ extern "C"
         uint32_t groupId;
     } ZuiButtonData;
 
+    ZUI_DEFINE_ARRAY(ZuiButtonData)
+
     void ZuiCenterWidgetInBounds(uint32_t itemId, Rectangle bounds);
     uint32_t ZuiCreateButton(const char *text, Texture2D *icon, ZuiButtonStyle style);
     void ZuiUpdateButton(uint32_t dataIndex);
@@ -1043,17 +1466,77 @@ extern "C"
         int menuDepth;
     } ZuiMenuContext;
 
+    // Startup sizing for ZuiInitEx, zero fields fall back to the built-in defaults
+    typedef struct ZuiConfig
+    {
+        size_t arenaSize;      // initially committed bytes of the persistent arena
+        size_t arenaReserve;   // address space reserved for it
+        size_t frameArenaSize; // initially committed bytes of the per-frame arena
+        uint32_t itemCapacity;
+        uint32_t typeCapacities[ZUI_TYPE_COUNT];           // built-in types only
+        uint32_t componentCapacities[ZUI_COMPONENT_COUNT]; // built-in components only
+        float growthFactor; // dynarray capacity multiplier, must be > 1
+        // When set, both arenas come from the host instead of reserved address space. Heap arenas cannot
+        // grow, they take ZUI_HEAP_ARENA_SCALE times arenaSize and frameArenaSize once (see ZuiSuggestConfig)
+        const ZuiAllocator *allocator;
+    } ZuiConfig;
+
+    // Snapshot taken by ZuiBeginTransientScope, everything allocated after it is rolled back. Item slots the
+    // scope used stay behind as free slots with their generation, so its ids never come back alive
+    typedef struct ZuiTransientScope
+    {
+        ZuiArenaMarker marker;
+        ZuiDynArray items;
+        ZuiDynArray freeItems;
+        ZuiComponentRegistry componentRegistry;
+        ZuiTypeRegistry typeRegistry;
+        ZuiComponentRegistration *components; // registration copies, allocated past the marker
+        ZuiTypeRegistration *types;
+        ZuiCursor cursor;
+        ZuiStringPool strings;
+        ZuiDynArray journal; // copies of pre-scope items taken before their first mutation
+        ZuiDynArray reusedItems; // slots free before the scope and handed out again, retired by the rollback
+        uint32_t freeLow;        // lowest freeItems count reached, entries above it were popped or overwritten
+        ZuiDynArray layoutQueue;
+        ZuiDynArray walkStack;
+        ZuiDynArray deferredRemovals;
+        ZuiWorldLanes worldLanes;
+        bool active;
+    } ZuiTransientScope;
+
+    // Wall-clock cost of the last ZuiUpdate/ZuiRender, for profiling large trees
+    typedef struct ZuiFrameStats
+    {
+        double updateMs;
+        double renderMs;
+        uint32_t itemCount;
+    } ZuiFrameStats;
+
     typedef struct ZuiContext
     {
         ZuiCursor cursor;
         ZuiWindowManager windowManager;
         ZuiDynArray items;
+        ZuiDynArray freeItems; // recycled item slot indices
         ZuiTypeRegistry typeRegistry;
         ZuiComponentRegistry componentRegistry;
         int dpiScale;
         ZuiTheme defaultTheme;
         ZuiFocusContext g_focusContext;
         ZuiMenuContext g_menuContext;
+        ZuiArena frameArena; // reset at the start of every ZuiUpdate
+        ZuiTransientScope transient;
+        ZuiConfig config;
+        ZuiStringPool strings; // interned label text
+        ZuiFrameStats frameStats;
+        ZuiDynArray layoutQueue; // finalized layouts whose size inputs changed, drained by ZuiUpdateLayout
+        uint32_t layoutPass;     // id of the running measure and arrange pass, 0 outside of one
+        uint32_t layoutPassSerial;
+        ZuiArenaMarker layoutPassMarker; // frame arena offset the running pass releases its records to
+        ZuiDynArray walkStack;           // shared by all tree walks, nested walks work above the outer one's entries
+        ZuiDynArray deferredRemovals;    // ZuiDeferredRemoval, flushed when iterationDepth drops to 0
+        uint32_t iterationDepth;         // open queries plus the systems pass of ZuiUpdateComponents
+        ZuiWorldLanes worldLanes;        // hit-test lanes, refreshed by ZuiUpdateComponents
     } ZuiContext;
 
 #ifdef __cplusplus
@@ -1068,6 +1551,28 @@ extern "C"
     }
 #endif
 
+#ifdef ZUI_FAST
+    // Only the NULL test survives, callers still branch on a missing context
+    static inline bool ZuiEnsureContext(const ZuiResult error_code, const char *msg)
+    {
+        (void)error_code;
+        (void)msg;
+        return g_zui_ctx != NULL;
+    }
+
+    // Stale ids still resolve to NULL, that is part of the API rather than validation
+    static inline const ZuiItem *ZuiGetItem(const uint32_t id)
+    {
+        const uint32_t index = id & ZUI_ID_INDEX_MASK;
+        if (id == ZUI_ID_INVALID || index >= g_zui_ctx->items.count)
+        {
+            return NULL;
+        }
+        const ZuiItem *item = ZuiItemArrayAt(&g_zui_ctx->items, index);
+        return item->id == id ? item : NULL;
+    }
+#endif
+
 #define ZUI_ASSERT_CTX_RETURN_FALSE()                    \
     do                                                   \
     {                                                    \
@@ -1098,15 +1603,33 @@ extern "C"
         }                                                \
     } while (0)
 
+// Frame allocations are valid until the next ZuiUpdate
+#define ZUI_FRAME_ALLOC_TYPE(type) \
+    ((type *)ZuiAllocFrame(sizeof(type), ZUI_ALIGNOF(type)))
+
+#define ZUI_FRAME_ALLOC_ARRAY(type, count) \
+    ((type *)ZuiAllocFrame(sizeof(type) * (count), ZUI_ALIGNOF(type)))
+
+    void *ZuiAllocFrame(size_t size, size_t alignment);
+    ZuiArenaStats ZuiGetFrameArenaStats(void);
+    ZuiResult ZuiBeginTransientScope(void);
+    void ZuiEndTransientScope(void);
+    bool ZuiInTransientScope(void);
+    ZuiFrameStats ZuiGetFrameStats(void);
     void ZuiAdvanceCursor(float width, float height);
     void ZuiAdvanceLine(void);
     void ZuiPlaceAt(float x, float y);
     void ZuiOffset(float x, float y);
     void ZuiUpdateRestPosition(void);
+#ifndef ZUI_FAST
     bool ZuiEnsureContext(ZuiResult error_code, const char *msg);
+#endif
     void ZuiUpdateComponents(void);
     void ZuiUpdate(void);
     void ZuiRender(void);
+    ZuiConfig ZuiDefaultConfig(void);
+    ZuiConfig ZuiSuggestConfig(void);
+    bool ZuiInitEx(const ZuiConfig *config);
     bool ZuiInit(void);
     void ZuiExit(void);
     void ZuiOffsetLast(float x, float y);
@@ -1143,7 +1666,10 @@ extern "C"
         case ZUI_KNOB:
             return "knob";
         default:
-            return "unknown";
+        {
+            const ZuiTypeRegistration *reg = ZuiGetTypeRegistration((uint32_t)type);
+            return reg && reg->name ? reg->name : "unknown";
+        }
         }
     }
 
@@ -1254,7 +1780,33 @@ extern "C"
     // -----------------------------------------------------------------------------
     // zui_arena.c
 
+    static void *ZuiHeapAlloc(size_t size, void *user)
+    {
+        (void)user;
+        return malloc(size);
+    }
+
+    static void ZuiHeapFree(void *ptr, size_t size, void *user)
+    {
+        (void)size;
+        (void)user;
+        free(ptr);
+    }
+
+    ZuiAllocator ZuiDefaultAllocator(void)
+    {
+        return (ZuiAllocator){
+            .alloc = ZuiHeapAlloc,
+            .free = ZuiHeapFree,
+        };
+    }
+
     ZuiResult ZuiInitArena(ZuiArena *arena, const size_t capacity)
+    {
+        return ZuiInitArenaEx(arena, capacity, NULL);
+    }
+
+    ZuiResult ZuiInitArenaEx(ZuiArena *arena, const size_t capacity, const ZuiAllocator *allocator)
     {
         if (!arena)
         {
@@ -1263,10 +1815,13 @@ extern "C"
         }
 
         // safe state FIRST (prevents use of uninitialized arena)
-        arena->buffer = NULL;
-        arena->offset = 0;
-        arena->capacity = 0;
-        arena->initialCapacity = 0;
+        *arena = (ZuiArena){0};
+
+        if (allocator && (!allocator->alloc || !allocator->free))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Allocator needs alloc and free");
+            return ZUI_ERROR_NULL_POINTER;
+        }
 
         if (capacity == 0)
         {
@@ -1284,7 +1839,8 @@ extern "C"
         }
 
         // Attempt allocation
-        arena->buffer = (unsigned char *)malloc(capacity);
+        arena->allocator = allocator ? *allocator : ZuiDefaultAllocator();
+        arena->buffer = (unsigned char *)arena->allocator.alloc(capacity, arena->allocator.user);
         // malloc fail
         if (!arena->buffer)
         {
@@ -1304,24 +1860,69 @@ extern "C"
         return ZUI_OK;
     }
 
-    void ZuiUnloadArena(ZuiArena *arena)
+    static size_t ZuiGetPageSize(void)
     {
-        if (!arena)
-        {
-            return;
-        }
+#if defined(_WIN32)
+        return 65536; // allocation granularity, also a multiple of the page size
+#elif ZUI_HAS_VIRTUAL_MEMORY
+        long pageSize = sysconf(_SC_PAGESIZE);
+        return pageSize > 0 ? (size_t)pageSize : 4096;
+#else
+        return 4096;
+#endif
+    }
 
-        if (arena->buffer != NULL)
-        {
-            free(arena->buffer);
-            arena->buffer = NULL;
-        }
-        arena->offset = 0;
-        arena->capacity = 0;
-        arena->initialCapacity = 0;
+    static size_t ZuiAlignToPage(const size_t size, const size_t pageSize)
+    {
+        return (size + pageSize - 1) & ~(pageSize - 1);
     }
 
-    ZuiResult ZuiGrowArena(ZuiArena *arena, const size_t requiredSize)
+    static void *ZuiReserveAddressSpace(const size_t size)
+    {
+#if defined(_WIN32)
+        return VirtualAlloc(NULL, size, 0x00002000 /* MEM_RESERVE */, 0x01 /* PAGE_NOACCESS */);
+#elif ZUI_HAS_VIRTUAL_MEMORY
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+        void *ptr = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return ptr == MAP_FAILED ? NULL : ptr;
+#else
+        (void)size;
+        return NULL;
+#endif
+    }
+
+    static bool ZuiCommitAddressSpace(void *ptr, const size_t size)
+    {
+#if defined(_WIN32)
+        return VirtualAlloc(ptr, size, 0x00001000 /* MEM_COMMIT */, 0x04 /* PAGE_READWRITE */) != NULL;
+#elif ZUI_HAS_VIRTUAL_MEMORY
+        return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#else
+        (void)ptr;
+        (void)size;
+        return false;
+#endif
+    }
+
+    static void ZuiReleaseAddressSpace(void *ptr, const size_t size)
+    {
+#if defined(_WIN32)
+        (void)size;
+        VirtualFree(ptr, 0, 0x00008000 /* MEM_RELEASE */);
+#elif ZUI_HAS_VIRTUAL_MEMORY
+        munmap(ptr, size);
+#else
+        (void)ptr;
+        (void)size;
+#endif
+    }
+
+    ZuiResult ZuiInitArenaVirtual(ZuiArena *arena, const size_t reserveSize, const size_t initialCommit)
     {
         if (!arena)
         {
@@ -1329,102 +1930,169 @@ extern "C"
             return ZUI_ERROR_NULL_POINTER;
         }
 
-        if (!arena->buffer)
+        *arena = (ZuiArena){0};
+
+        if (!ZUI_HAS_VIRTUAL_MEMORY)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena buffer is NULL");
-            return ZUI_ERROR_NULL_POINTER;
+            return ZUI_ERROR_NOT_IMPLEMENTED;
         }
 
-        if (arena->initialCapacity == 0)
+        if (initialCommit == 0 || reserveSize < initialCommit || reserveSize > SIZE_MAX / 2)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Arena initial capacity is zero");
-            return ZUI_ERROR_INVALID_STATE;
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_CAPACITY,
+                             "Invalid virtual arena sizes: reserve %zu, commit %zu", reserveSize, initialCommit);
+            return ZUI_ERROR_INVALID_CAPACITY;
         }
 
-        // Calculate maximum allowed capacity (4x initial)
-        const size_t maxCapacity = arena->initialCapacity * 4;
+        const size_t pageSize = ZuiGetPageSize();
+        const size_t reserved = ZuiAlignToPage(reserveSize, pageSize);
+        const size_t committed = ZuiAlignToPage(initialCommit, pageSize);
 
-        // Check if we're already at max capacity
-        if (arena->capacity >= maxCapacity)
+        unsigned char *buffer = (unsigned char *)ZuiReserveAddressSpace(reserved);
+        if (!buffer)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_ARENA_EXHAUSTED,
-                             "Arena at maximum capacity (%zu bytes, 4x initial %zu bytes)",
-                             arena->capacity, arena->initialCapacity);
-            return ZUI_ERROR_ARENA_EXHAUSTED;
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to reserve %zu bytes of address space", reserved);
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+
+        if (!ZuiCommitAddressSpace(buffer, committed))
+        {
+            ZuiReleaseAddressSpace(buffer, reserved);
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to commit %zu bytes", committed);
+            return ZUI_ERROR_OUT_OF_MEMORY;
         }
 
-        // Calculate new capacity (double current)
-        size_t newCapacity = arena->capacity * 2;
+        arena->buffer = buffer;
+        arena->capacity = committed;
+        arena->initialCapacity = committed;
+        arena->reserved = reserved;
+        arena->isVirtual = true;
+
+#ifdef ZUI_DEBUG
+        TraceLog(LOG_INFO, "ZUI: Virtual arena reserved %zu bytes, committed %zu bytes", reserved, committed);
+#endif
+
+        return ZUI_OK;
+    }
 
-        // Check for overflow in doubling
-        if (newCapacity < arena->capacity)
+    void ZuiUnloadArena(ZuiArena *arena)
+    {
+        if (!arena)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OVERFLOW, "Arena capacity doubling caused overflow");
-            return ZUI_ERROR_OVERFLOW;
+            return;
         }
 
-        // Cap at maximum capacity
-        if (newCapacity > maxCapacity)
+        if (arena->buffer != NULL)
         {
-            newCapacity = maxCapacity;
+            if (arena->isVirtual)
+            {
+                ZuiReleaseAddressSpace(arena->buffer, arena->reserved);
+            }
+            else
+            {
+                arena->allocator.free(arena->buffer, arena->capacity, arena->allocator.user);
+            }
+            arena->buffer = NULL;
         }
+        arena->offset = 0;
+        arena->capacity = 0;
+        arena->initialCapacity = 0;
+        arena->reserved = 0;
+        arena->isVirtual = false;
+    }
 
-        // Ensure new capacity can fit the required size
-        if (requiredSize > newCapacity)
+    static ZuiResult ZuiGrowArenaVirtual(ZuiArena *arena, const size_t requiredSize)
+    {
+        if (requiredSize > arena->reserved)
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_ARENA_EXHAUSTED,
-                             "Required size %zu exceeds maximum arena capacity %zu",
-                             requiredSize, newCapacity);
+                             "Required size %zu exceeds reserved address space %zu",
+                             requiredSize, arena->reserved);
             return ZUI_ERROR_ARENA_EXHAUSTED;
         }
 
-        // Attempt reallocation
-        unsigned char *newBuffer = (unsigned char *)realloc(arena->buffer, newCapacity);
-        if (!newBuffer)
+        // Commit at least double so growth stays amortized, never past the reservation
+        size_t newCapacity = arena->capacity <= arena->reserved / 2 ? arena->capacity * 2 : arena->reserved;
+        if (newCapacity < requiredSize)
+        {
+            newCapacity = ZuiAlignToPage(requiredSize, ZuiGetPageSize());
+        }
+
+        if (!ZuiCommitAddressSpace(arena->buffer + arena->capacity, newCapacity - arena->capacity))
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY,
-                             "Failed to reallocate arena from %zu to %zu bytes",
-                             arena->capacity, newCapacity);
+                             "Failed to commit arena from %zu to %zu bytes", arena->capacity, newCapacity);
             return ZUI_ERROR_OUT_OF_MEMORY;
         }
 
-        arena->buffer = newBuffer;
-        arena->capacity = newCapacity;
-
 #ifdef ZUI_DEBUG
-        TraceLog(LOG_INFO, "ZUI: Arena grew from %zu to %zu bytes (max: %zu bytes)",
-                 arena->capacity / 2, arena->capacity, maxCapacity);
+        TraceLog(LOG_INFO, "ZUI: Arena committed %zu to %zu bytes (reserved: %zu bytes)",
+                 arena->capacity, newCapacity, arena->reserved);
 #endif
 
+        arena->capacity = newCapacity;
         return ZUI_OK;
     }
 
-    void *ZuiAllocArena(ZuiArena *arena, size_t size, const size_t alignment)
+    ZuiResult ZuiGrowArena(ZuiArena *arena, const size_t requiredSize)
     {
         if (!arena)
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena pointer is NULL");
-            return NULL;
+            return ZUI_ERROR_NULL_POINTER;
         }
 
-        if (!ZuiIsPowerOfTwo(alignment))
+        if (!arena->buffer)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ALIGNMENT,
-                             "Alignment %zu must be a power of two", alignment);
-            return NULL;
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena buffer is NULL");
+            return ZUI_ERROR_NULL_POINTER;
         }
 
-        if (!(arena->buffer != NULL &&
-              arena->offset <= arena->capacity))
+        if (arena->initialCapacity == 0)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Arena is in invalid state");
-            return NULL;
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Arena initial capacity is zero");
+            return ZUI_ERROR_INVALID_STATE;
         }
 
-        // Explicit check for arena buffer (helps analyzers)
-        if (arena->buffer == NULL)
+        if (arena->isVirtual)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena buffer is NULL");
+            return ZuiGrowArenaVirtual(arena, requiredSize);
+        }
+
+        // Everything in the arena is addressed by pointer, so a heap buffer is never reallocated
+        ZUI_REPORT_ERROR(ZUI_ERROR_ARENA_EXHAUSTED,
+                         "Required size %zu exceeds heap arena capacity %zu, raise the arena size",
+                         requiredSize, arena->capacity);
+        return ZUI_ERROR_ARENA_EXHAUSTED;
+    }
+
+#ifndef ZUI_FAST
+    void *ZuiAllocArena(ZuiArena *arena, size_t size, const size_t alignment)
+    {
+        if (!arena)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena pointer is NULL");
+            return NULL;
+        }
+
+        if (!ZuiIsPowerOfTwo(alignment))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ALIGNMENT,
+                             "Alignment %zu must be a power of two", alignment);
+            return NULL;
+        }
+
+        if (!(arena->buffer != NULL &&
+              arena->offset <= arena->capacity))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Arena is in invalid state");
+            return NULL;
+        }
+
+        // Explicit check for arena buffer (helps analyzers)
+        if (arena->buffer == NULL)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena buffer is NULL");
             return NULL;
         }
 
@@ -1449,9 +2117,11 @@ extern "C"
             return NULL;
         }
 
+        // Align the address, heap buffers from a ZuiAllocator only come with malloc's alignment
         const size_t current_offset = arena->offset;
         const size_t mask = alignment - 1;
-        const size_t aligned_offset = (current_offset + mask) & ~mask;
+        const size_t aligned_offset =
+            current_offset + (size_t)((0 - (uintptr_t)(arena->buffer + current_offset)) & mask);
 
         // overflow in padding
         if (aligned_offset < current_offset)
@@ -1493,9 +2163,14 @@ extern "C"
         }
 
         arena->offset = aligned_offset + size;
+        if (arena->offset > arena->highWater)
+        {
+            arena->highWater = arena->offset;
+        }
         memset(ptr, 0, size);
         return ptr;
     }
+#endif
 
     void ZuiResetArena(ZuiArena *arena)
     {
@@ -1506,6 +2181,8 @@ extern "C"
         }
 
         arena->offset = 0;
+        memset(arena->freeLists, 0, sizeof(arena->freeLists));
+        arena->freeBytes = 0;
     }
 
     void *ZuiAllocArenaDefault(ZuiArena *arena, const size_t size)
@@ -1540,10 +2217,225 @@ extern "C"
         stats.availableBytes = arena->capacity - arena->offset;
         stats.usagePercent = (float)arena->offset / (float)arena->capacity * 100.0F;
         stats.initialCapacity = arena->initialCapacity;
-        stats.maxCapacity = arena->initialCapacity * 4;
+        stats.maxCapacity = arena->isVirtual ? arena->reserved : arena->capacity;
+        stats.reservedBytes = arena->isVirtual ? arena->reserved : arena->capacity;
+        stats.committedBytes = arena->capacity;
+        stats.highWaterBytes = arena->highWater;
+        stats.freeBytes = arena->freeBytes;
+
+        return stats;
+    }
+
+    static ZuiArenaTypeStats *ZuiFindArenaTypeStats(ZuiArena *arena, const char *typeName)
+    {
+        if (!typeName)
+        {
+            return NULL;
+        }
+
+        for (uint32_t i = 0; i < arena->typeStatsCount; i++)
+        {
+            if (arena->typeStats[i].typeName == typeName || strcmp(arena->typeStats[i].typeName, typeName) == 0)
+            {
+                return &arena->typeStats[i];
+            }
+        }
+
+        if (arena->typeStatsCount >= ZUI_ARENA_MAX_TYPE_STATS)
+        {
+            return NULL;
+        }
 
+        ZuiArenaTypeStats *stats = &arena->typeStats[arena->typeStatsCount++];
+        *stats = (ZuiArenaTypeStats){.typeName = typeName};
         return stats;
     }
+
+    // Smallest class whose block holds size, ZUI_ARENA_SIZE_CLASSES if none does
+    static uint32_t ZuiArenaSizeClass(const size_t size)
+    {
+        uint32_t sizeClass = 0;
+        while (sizeClass < ZUI_ARENA_SIZE_CLASSES &&
+               ((size_t)1 << (sizeClass + ZUI_ARENA_MIN_BLOCK_SHIFT)) < size)
+        {
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+
+    void *ZuiAllocArenaBlock(ZuiArena *arena, const size_t size, const size_t alignment, const char *typeName,
+                             size_t *blockSize)
+    {
+        if (!arena || !blockSize)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena or block size pointer is NULL");
+            return NULL;
+        }
+
+        const uint32_t sizeClass = ZuiArenaSizeClass(size);
+
+        // Blocks are only guaranteed default alignment, oversized requests bypass the free lists
+        if (size == 0 || alignment > ZUI_DEFAULT_ALIGNMENT || sizeClass >= ZUI_ARENA_SIZE_CLASSES)
+        {
+            *blockSize = size;
+            return ZuiAllocArena(arena, size, alignment);
+        }
+
+        const size_t bytes = (size_t)1 << (sizeClass + ZUI_ARENA_MIN_BLOCK_SHIFT);
+
+        if (arena->freeLists[sizeClass] != 0 && !arena->recycleSuspended)
+        {
+            unsigned char *block = arena->buffer + (arena->freeLists[sizeClass] - 1);
+            memcpy(&arena->freeLists[sizeClass], block, sizeof(size_t)); /* Flawfinder: ignore */
+            arena->freeBytes -= bytes;
+
+            ZuiArenaTypeStats *stats = ZuiFindArenaTypeStats(arena, typeName);
+            if (stats)
+            {
+                stats->reclaimedBytes += bytes;
+            }
+
+            memset(block, 0, bytes);
+            *blockSize = bytes;
+            return block;
+        }
+
+        void *block = ZuiAllocArena(arena, bytes, ZUI_DEFAULT_ALIGNMENT);
+        *blockSize = block ? bytes : 0;
+        return block;
+    }
+
+    void ZuiFreeArenaBlock(ZuiArena *arena, void *ptr, const size_t size, const char *typeName)
+    {
+        if (!arena || !ptr || size == 0 || arena->recycleSuspended)
+        {
+            return;
+        }
+
+        const uintptr_t base = (uintptr_t)arena->buffer;
+        uintptr_t start = (uintptr_t)ptr;
+        if (start < base || start - base >= arena->offset || size > arena->offset - (start - base))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Block does not belong to the arena");
+            return;
+        }
+
+        ZuiArenaTypeStats *stats = ZuiFindArenaTypeStats(arena, typeName);
+
+        // Carve the block into aligned power-of-two pieces, largest first
+        const size_t mask = ZUI_DEFAULT_ALIGNMENT - 1;
+        const uintptr_t end = start + size;
+        start = (start + mask) & ~(uintptr_t)mask;
+
+        size_t minBlock = (size_t)1 << ZUI_ARENA_MIN_BLOCK_SHIFT;
+        if (minBlock < ZUI_DEFAULT_ALIGNMENT)
+        {
+            minBlock = ZUI_DEFAULT_ALIGNMENT;
+        }
+
+        size_t released = 0;
+        while (start < end && end - start >= minBlock)
+        {
+            uint32_t sizeClass = ZuiArenaSizeClass(end - start);
+            if (sizeClass >= ZUI_ARENA_SIZE_CLASSES ||
+                ((size_t)1 << (sizeClass + ZUI_ARENA_MIN_BLOCK_SHIFT)) > end - start)
+            {
+                sizeClass--;
+            }
+
+            const size_t bytes = (size_t)1 << (sizeClass + ZUI_ARENA_MIN_BLOCK_SHIFT);
+            memcpy((void *)start, &arena->freeLists[sizeClass], sizeof(size_t)); /* Flawfinder: ignore */
+            arena->freeLists[sizeClass] = (size_t)(start - base) + 1;
+            arena->freeBytes += bytes;
+            released += bytes;
+            start += bytes;
+        }
+
+        if (stats)
+        {
+            stats->releasedBytes += released;
+            stats->wastedBytes += size - released;
+        }
+    }
+
+    ZuiArenaTypeStats ZuiGetArenaTypeStats(const ZuiArena *arena, const char *typeName)
+    {
+        if (!arena || !typeName)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena or type name is NULL");
+            return (ZuiArenaTypeStats){0};
+        }
+
+        for (uint32_t i = 0; i < arena->typeStatsCount; i++)
+        {
+            if (strcmp(arena->typeStats[i].typeName, typeName) == 0)
+            {
+                return arena->typeStats[i];
+            }
+        }
+
+        return (ZuiArenaTypeStats){.typeName = typeName};
+    }
+
+    ZuiArenaMarker ZuiArenaMark(const ZuiArena *arena)
+    {
+        if (!arena)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena pointer is NULL");
+            return (ZuiArenaMarker){0};
+        }
+        return (ZuiArenaMarker){.offset = arena->offset};
+    }
+
+    void ZuiArenaRestore(ZuiArena *arena, const ZuiArenaMarker marker)
+    {
+        if (!arena)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Arena pointer is NULL");
+            return;
+        }
+
+        if (marker.offset > arena->offset)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Marker %zu is past the arena offset %zu",
+                             marker.offset, arena->offset);
+            return;
+        }
+
+        // Drop free blocks that lie in the released range
+        for (uint32_t sizeClass = 0; sizeClass < ZUI_ARENA_SIZE_CLASSES; sizeClass++)
+        {
+            const size_t bytes = (size_t)1 << (sizeClass + ZUI_ARENA_MIN_BLOCK_SHIFT);
+            unsigned char *prev = NULL;
+            size_t current = arena->freeLists[sizeClass];
+            while (current != 0)
+            {
+                const size_t blockOffset = current - 1;
+                size_t next = 0;
+                memcpy(&next, arena->buffer + blockOffset, sizeof(size_t)); /* Flawfinder: ignore */
+                if (blockOffset + bytes > marker.offset)
+                {
+                    if (prev)
+                    {
+                        memcpy(prev, &next, sizeof(size_t)); /* Flawfinder: ignore */
+                    }
+                    else
+                    {
+                        arena->freeLists[sizeClass] = next;
+                    }
+                    arena->freeBytes -= bytes;
+                }
+                else
+                {
+                    prev = arena->buffer + blockOffset;
+                }
+                current = next;
+            }
+        }
+
+        arena->offset = marker.offset;
+    }
+
     // -----------------------------------------------------------------------------
     // zui_dynarray.c
 
@@ -1623,15 +2515,9 @@ extern "C"
             return ZUI_ERROR_OUT_OF_MEMORY;
         }
 
-        if (required_bytes > arena->capacity - arena->offset)
-        {
-            ZUI_REPORT_ERROR(ZUI_ERROR_ARENA_EXHAUSTED,
-                             "Not enough arena space for %s array: need %zu, have %zu",
-                             typeName, required_bytes, arena->capacity - arena->offset);
-            return ZUI_ERROR_ARENA_EXHAUSTED;
-        }
-
-        void *items = ZuiAllocArena(arena, required_bytes, itemAlignment);
+        // ZuiAllocArena grows the arena when the array does not fit
+        size_t block_bytes = 0;
+        void *items = ZuiAllocArenaBlock(arena, required_bytes, itemAlignment, typeName, &block_bytes);
         // occurs if ZuiAllocArena returns NULL even when the arena has sufficient capacity
         // memory fault or a bug in the arena allocator itself.
         if (!items)
@@ -1641,9 +2527,16 @@ extern "C"
             return ZUI_ERROR_ALLOCATION_FAILED;
         }
 
+        // Use the whole size-class block
+        size_t block_capacity = block_bytes / itemSize;
+        if (block_capacity > ZUI_MAX_DYNARRAY_CAPACITY)
+        {
+            block_capacity = ZUI_MAX_DYNARRAY_CAPACITY;
+        }
+
         array->items = items;
         array->count = 0;
-        array->capacity = initialCapacity;
+        array->capacity = (uint32_t)block_capacity;
         array->itemSize = itemSize;
         array->itemAlignment = itemAlignment;
         array->typeName = typeName;
@@ -1675,13 +2568,19 @@ extern "C"
             return ZUI_ERROR_INVALID_STATE;
         }
 
-        if (array->capacity > UINT_MAX / 2)
+        const float growthFactor = arena->growthFactor > 1.0F ? arena->growthFactor : 2.0F;
+        const double grown = (double)array->capacity * (double)growthFactor;
+        if (grown > (double)(UINT_MAX - 1))
         {
             TraceLog(LOG_ERROR, "ZUI: DynArray capacity would overflow on growth");
             return ZUI_ERROR_OVERFLOW;
         }
 
-        uint32_t new_capacity = array->capacity * 2;
+        uint32_t new_capacity = (uint32_t)grown;
+        if (new_capacity <= array->capacity)
+        {
+            new_capacity = array->capacity + 1;
+        }
 
         if (new_capacity > ZUI_MAX_DYNARRAY_CAPACITY)
         {
@@ -1703,11 +2602,14 @@ extern "C"
             current_bytes = (size_t)array->count * array->itemSize;
         }
 
-        TraceLog(LOG_INFO, "ZUI: Growing dynarray '%s' from %u to %u capacity (%zu to %zu bytes)",
+#ifdef ZUI_DEBUG
+        TraceLog(LOG_DEBUG, "ZUI: Growing dynarray '%s' from %u to %u capacity (%zu to %zu bytes)",
                  array->typeName ? array->typeName : "unknown",
                  array->capacity, new_capacity, current_bytes, new_bytes);
+#endif
 
-        void *new_items = ZuiAllocArena(arena, new_bytes, _Alignof(max_align_t));
+        size_t block_bytes = 0;
+        void *new_items = ZuiAllocArenaBlock(arena, new_bytes, array->itemAlignment, array->typeName, &block_bytes);
         if (!new_items)
         {
             TraceLog(LOG_ERROR, "ZUI: Failed to allocate %zu bytes from arena for %s array growth",
@@ -1720,12 +2622,22 @@ extern "C"
             memcpy(new_items, array->items, current_bytes); /* Flawfinder: ignore */
         }
 
+        // The old block goes back to the arena free lists for later pushes
+        ZuiFreeArenaBlock(arena, array->items, (size_t)array->capacity * array->itemSize, array->typeName);
+
+        size_t block_capacity = block_bytes / array->itemSize;
+        if (block_capacity > ZUI_MAX_DYNARRAY_CAPACITY)
+        {
+            block_capacity = ZUI_MAX_DYNARRAY_CAPACITY;
+        }
+
         array->items = new_items;
-        array->capacity = new_capacity;
+        array->capacity = (uint32_t)block_capacity;
 
         return ZUI_OK;
     }
 
+#ifndef ZUI_FAST
     void *ZuiPushDynArray(ZuiDynArray *array, ZuiArena *arena)
     {
         if (!array || !arena)
@@ -1796,6 +2708,7 @@ extern "C"
         size_t byte_offset = array->itemSize * (size_t)index;
         return (char *)array->items + byte_offset;
     }
+#endif
 
     void ZuiClearDynArray(ZuiDynArray *array)
     {
@@ -1830,122 +2743,982 @@ extern "C"
         stats.memoryUsed = array->itemSize * array->capacity;
         return stats;
     }
-    // -----------------------------------------------------------------------------
-    // zui_component.c
-    // #include "zui_menu.h"
-    // #include "zui_window.h"
 
-    const ZuiComponentRegistration COMPONENT_TABLE[] = {
-        {
-            .name = "Transform",
-            .dataSize = sizeof(ZuiTransformData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiTransformData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
-        {
-            .name = "Layout",
-            .dataSize = sizeof(ZuiLayoutData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiLayoutData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
-            .requiredComponentCount = 1,
-        },
-        {
-            .name = "Align",
-            .dataSize = sizeof(ZuiAlignData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiAlignData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
-        {
-            .name = "Interaction",
-            .dataSize = sizeof(ZuiInteractionData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiInteractionData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
-            .requiredComponentCount = 1,
-        },
-        {
-            .name = "State",
-            .dataSize = sizeof(ZuiStateData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiStateData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
-        {
-            .name = "Animation",
-            .dataSize = sizeof(ZuiAnimationData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiAnimationData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
-        {
-            .name = "Focus",
-            .dataSize = sizeof(ZuiFocusData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiFocusData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
-        {
-            .name = "Scroll",
-            .dataSize = sizeof(ZuiScrollData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiScrollData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
-            .requiredComponentCount = 1,
-        },
-        {
-            .name = "Layer",
-            .dataSize = sizeof(ZuiLayerData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiLayerData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-        },
+    static ZuiResult ZuiAddPage(ZuiPagedArray *array, ZuiArena *arena)
+    {
+        void **pageSlot = (void **)ZuiPushDynArray(&array->pages, arena);
+        if (!pageSlot)
         {
-            .name = "Spatial",
-            .dataSize = sizeof(ZuiSpatialData),
-            .dataAlignment = ZUI_ALIGNOF(ZuiSpatialData),
-            .initialCapacity = ZUI_ITEMS_CAPACITY,
-            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
-            .requiredComponentCount = 1,
-        },
-    };
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
 
-    ZuiResult ZuiInitComponentRegistry(void)
-    {
-        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        size_t blockBytes = 0;
+        void *page = ZuiAllocArenaBlock(arena, array->itemSize * ZUI_PAGE_SIZE, array->itemAlignment,
+                                        array->typeName, &blockBytes);
+        if (!page)
         {
-            return ZUI_ERROR_NULL_CONTEXT;
+            array->pages.count--;
+            TraceLog(LOG_ERROR, "ZUI: Failed to allocate %s page", array->typeName);
+            return ZUI_ERROR_OUT_OF_MEMORY;
         }
-        memset(&g_zui_ctx->componentRegistry, 0, sizeof(ZuiComponentRegistry));
-        TraceLog(LOG_INFO, "ZUI: Component registry initialized");
+
+        *pageSlot = page;
         return ZUI_OK;
     }
 
-    ZuiResult ZuiRegisterComponent(ZuiComponentId componentId, const ZuiComponentRegistration *info)
+    ZuiResult ZuiInitPagedArray(ZuiPagedArray *array, ZuiArena *arena, uint32_t initialCapacity,
+                                size_t itemSize, size_t itemAlignment, const char *typeName)
     {
-        if (!g_zui_ctx || !info)
+        if (!array || !arena || !typeName)
         {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Invalid parameters to ZuiInitPagedArray");
             return ZUI_ERROR_NULL_POINTER;
         }
-        uint32_t idx = (uint32_t)componentId;
-        if (idx >= ZUI_COMPONENT_COUNT)
+
+        if (itemSize == 0 || itemSize > SIZE_MAX / ZUI_PAGE_SIZE)
         {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "%s paged array item size %zu is invalid", typeName, itemSize);
             return ZUI_ERROR_INVALID_VALUE;
         }
 
-        ZuiComponentRegistry *reg = &g_zui_ctx->componentRegistry;
-        ZuiComponentRegistration *slot = &reg->registrations[idx];
+        const uint32_t pageCount = initialCapacity > 0 ? ((initialCapacity - 1) >> ZUI_PAGE_SHIFT) + 1 : 1;
+        *array = (ZuiPagedArray){
+            .itemSize = itemSize,
+            .itemAlignment = itemAlignment,
+            .typeName = typeName,
+        };
 
-        slot->name = info->name;
-        slot->dataSize = info->dataSize;
-        slot->dataAlignment = info->dataAlignment;
-        slot->initialCapacity = info->initialCapacity;
+        ZuiResult result = ZuiInitDynArray(&array->pages, arena, pageCount, sizeof(void *),
+                                           ZUI_ALIGNOF(void *), "Pages");
+        for (uint32_t i = 0; result == ZUI_OK && i < pageCount; i++)
+        {
+            result = ZuiAddPage(array, arena);
+        }
+        return result;
+    }
+
+    void *ZuiPushPagedArray(ZuiPagedArray *array, ZuiArena *arena)
+    {
+        if (!array || !arena || !array->pages.items)
+        {
+            return NULL;
+        }
+
+        if (array->count >= ZUI_MAX_DYNARRAY_CAPACITY)
+        {
+            TraceLog(LOG_ERROR, "ZUI: Paged array %s exceeds max capacity %u", array->typeName,
+                     ZUI_MAX_DYNARRAY_CAPACITY);
+            return NULL;
+        }
+
+        if ((array->count >> ZUI_PAGE_SHIFT) >= array->pages.count && ZuiAddPage(array, arena) != ZUI_OK)
+        {
+            return NULL;
+        }
+
+        const uint32_t index = array->count++;
+        return ZuiGetPagedArray(array, index);
+    }
+
+    void *ZuiGetPagedArray(const ZuiPagedArray *array, const uint32_t index)
+    {
+        if (!array)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Paged array pointer is NULL");
+            return NULL;
+        }
+
+        if (index >= array->count)
+        {
+            TraceLog(LOG_ERROR, "ZUI: Invalid %s array index %u (count: %u)",
+                     array->typeName, index, array->count);
+            return NULL;
+        }
+
+        char *page = ((char **)array->pages.items)[index >> ZUI_PAGE_SHIFT];
+        return page + (array->itemSize * (size_t)(index & ZUI_PAGE_MASK));
+    }
+
+    // Moves the last element into index and zeroes the vacated tail slot
+    void ZuiSwapRemovePagedArray(ZuiPagedArray *array, const uint32_t index)
+    {
+        if (!array || index >= array->count)
+        {
+            return;
+        }
+
+        const uint32_t last = array->count - 1;
+        void *tail = ZuiGetPagedArray(array, last);
+        if (index != last)
+        {
+            memcpy(ZuiGetPagedArray(array, index), tail, array->itemSize); /* Flawfinder: ignore */
+        }
+        memset(tail, 0, array->itemSize);
+        array->count--;
+    }
+
+    uint32_t ZuiGetPagedArrayCapacity(const ZuiPagedArray *array)
+    {
+        return array ? array->pages.count << ZUI_PAGE_SHIFT : 0;
+    }
+
+    // Unchecked element access for indices the caller already validated
+    static inline void *ZuiPagedArrayAt(const ZuiPagedArray *array, const uint32_t index)
+    {
+        char *page = ((char *const *)array->pages.items)[index >> ZUI_PAGE_SHIFT];
+        return page + (array->itemSize * (size_t)(index & ZUI_PAGE_MASK));
+    }
+    // -----------------------------------------------------------------------------
+    // zui_string.c
+
+    static uint32_t ZuiHashString(const char *text, size_t length)
+    {
+        uint32_t hash = 2166136261u; // FNV-1a
+        for (size_t i = 0; i < length; i++)
+        {
+            hash ^= (unsigned char)text[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    ZuiResult ZuiInitStringPool(ZuiStringPool *pool, ZuiArena *arena)
+    {
+        if (!pool || !arena)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Invalid parameters to ZuiInitStringPool");
+            return ZUI_ERROR_NULL_POINTER;
+        }
+
+        *pool = (ZuiStringPool){0};
+        ZuiResult result = ZuiInitDynArray(&pool->bytes, arena, ZUI_STRING_BYTES_CAPACITY,
+                                           sizeof(char), ZUI_ALIGNOF(char), "StringBytes");
+        if (result == ZUI_OK)
+        {
+            result = ZuiInitDynArray(&pool->entries, arena, ZUI_STRINGS_CAPACITY,
+                                     sizeof(ZuiStringEntry), ZUI_ALIGNOF(ZuiStringEntry), "StringEntries");
+        }
+        if (result == ZUI_OK)
+        {
+            result = ZuiInitDynArray(&pool->buckets, arena, ZUI_STRING_BUCKETS,
+                                     sizeof(uint32_t), ZUI_ALIGNOF(uint32_t), "StringBuckets");
+        }
+        if (result != ZUI_OK)
+        {
+            return result;
+        }
+
+        pool->buckets.count = ZUI_STRING_BUCKETS;
+        memset(pool->buckets.items, 0, (size_t)pool->buckets.count * sizeof(uint32_t));
+        return ZUI_OK;
+    }
+
+    static void ZuiInsertStringBucket(ZuiDynArray *buckets, uint32_t hash, uint32_t handle)
+    {
+        uint32_t *slots = (uint32_t *)buckets->items;
+        const uint32_t mask = buckets->count - 1;
+        uint32_t slot = hash & mask;
+        while (slots[slot] != ZUI_STRING_NONE)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = handle;
+    }
+
+    // Rebuilds the table once handles and tombstones pass 3/4 load, doubling it unless tombstones were the bulk
+    static ZuiResult ZuiRehashStringBuckets(ZuiStringPool *pool, ZuiArena *arena)
+    {
+        const ZuiStringEntry *entries = (const ZuiStringEntry *)pool->entries.items;
+        uint32_t live = 0;
+        for (uint32_t i = 0; i < pool->entries.count; i++)
+        {
+            live += entries[i].refs > 0 ? 1u : 0u;
+        }
+
+        const uint32_t bucketCount = (live + 1) * 2 > pool->buckets.count ? pool->buckets.count * 2
+                                                                           : pool->buckets.count;
+        ZuiDynArray buckets = {0};
+        ZuiResult result = ZuiInitDynArray(&buckets, arena, bucketCount,
+                                           sizeof(uint32_t), ZUI_ALIGNOF(uint32_t), "StringBuckets");
+        if (result != ZUI_OK)
+        {
+            return result;
+        }
+
+        buckets.count = bucketCount;
+        memset(buckets.items, 0, (size_t)bucketCount * sizeof(uint32_t));
+        for (uint32_t i = 0; i < pool->entries.count; i++)
+        {
+            if (entries[i].refs > 0)
+            {
+                ZuiInsertStringBucket(&buckets, entries[i].hash, i + 1);
+            }
+        }
+
+        ZuiFreeArenaBlock(arena, pool->buckets.items, (size_t)pool->buckets.capacity * sizeof(uint32_t),
+                          pool->buckets.typeName);
+        pool->buckets = buckets;
+        pool->occupied = live;
+        return ZUI_OK;
+    }
+
+    // Copies live strings into a fresh block of the same capacity, dropping the bytes of released ones
+    static ZuiResult ZuiRepackStringBytes(ZuiStringPool *pool, ZuiArena *arena)
+    {
+        ZuiDynArray bytes = {0};
+        ZuiResult result = ZuiInitDynArray(&bytes, arena, pool->bytes.capacity, sizeof(char), ZUI_ALIGNOF(char),
+                                           pool->bytes.typeName);
+        if (result != ZUI_OK)
+        {
+            return result;
+        }
+
+        ZuiStringEntry *entries = (ZuiStringEntry *)pool->entries.items;
+        for (uint32_t i = 0; i < pool->entries.count; i++)
+        {
+            if (entries[i].refs > 0)
+            {
+                memcpy((char *)bytes.items + bytes.count, (const char *)pool->bytes.items + entries[i].offset, /* Flawfinder: ignore */
+                       (size_t)entries[i].length + 1);
+                entries[i].offset = bytes.count;
+                bytes.count += entries[i].length + 1;
+            }
+        }
+
+        ZuiFreeArenaBlock(arena, pool->bytes.items, pool->bytes.capacity, pool->bytes.typeName);
+        pool->bytes = bytes;
+        pool->deadBytes = 0;
+        return ZUI_OK;
+    }
+
+    // A tombstone right before an empty bucket ends no probe chain, so those are emptied too
+    static void ZuiClearStringBucket(ZuiStringPool *pool, uint32_t slot)
+    {
+        uint32_t *slots = (uint32_t *)pool->buckets.items;
+        const uint32_t mask = pool->buckets.count - 1;
+        if (slots[(slot + 1) & mask] != ZUI_STRING_NONE)
+        {
+            slots[slot] = ZUI_STRING_TOMBSTONE;
+            return;
+        }
+
+        slots[slot] = ZUI_STRING_NONE;
+        pool->occupied--;
+        for (slot = (slot - 1) & mask; slots[slot] == ZUI_STRING_TOMBSTONE; slot = (slot - 1) & mask)
+        {
+            slots[slot] = ZUI_STRING_NONE;
+            pool->occupied--;
+        }
+    }
+
+    uint32_t ZuiInternString(ZuiStringPool *pool, ZuiArena *arena, const char *text)
+    {
+        if (!pool || !arena || !text || !pool->buckets.items)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Invalid parameters to ZuiInternString");
+            return ZUI_STRING_NONE;
+        }
+
+        const size_t length = strlen(text);
+        if (length >= ZUI_MAX_DYNARRAY_CAPACITY)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OVERFLOW, "String of %zu bytes is too long to pool", length);
+            return ZUI_STRING_NONE;
+        }
+
+        const uint32_t hash = ZuiHashString(text, length);
+        uint32_t *slots = (uint32_t *)pool->buckets.items;
+        ZuiStringEntry *entries = (ZuiStringEntry *)pool->entries.items;
+        const uint32_t mask = pool->buckets.count - 1;
+        uint32_t tombstone = UINT32_MAX;
+        for (uint32_t slot = hash & mask; slots[slot] != ZUI_STRING_NONE; slot = (slot + 1) & mask)
+        {
+            if (slots[slot] == ZUI_STRING_TOMBSTONE)
+            {
+                tombstone = tombstone == UINT32_MAX ? slot : tombstone;
+                continue;
+            }
+            ZuiStringEntry *entry = &entries[slots[slot] - 1];
+            if (entry->hash == hash && entry->length == length &&
+                memcmp((const char *)pool->bytes.items + entry->offset, text, length) == 0)
+            {
+                entry->refs += pool->frozen ? 0u : 1u;
+                return slots[slot];
+            }
+        }
+
+        // A frozen pool only appends past the first empty bucket, so the rollback can simply clear it again
+        if (pool->frozen || tombstone == UINT32_MAX)
+        {
+            tombstone = UINT32_MAX;
+            if ((pool->occupied + 1) * 4 > pool->buckets.count * 3 && ZuiRehashStringBuckets(pool, arena) != ZUI_OK)
+            {
+                return ZUI_STRING_NONE;
+            }
+        }
+
+        const size_t spare = pool->bytes.capacity - pool->bytes.count;
+        if (spare < length + 1 && !pool->frozen && pool->deadBytes >= pool->bytes.capacity / 4 &&
+            spare + pool->deadBytes >= length + 1 && ZuiRepackStringBytes(pool, arena) != ZUI_OK)
+        {
+            return ZUI_STRING_NONE;
+        }
+        while (pool->bytes.capacity - pool->bytes.count < length + 1)
+        {
+            if (ZuiGrowDynArray(&pool->bytes, arena) != ZUI_OK)
+            {
+                return ZUI_STRING_NONE;
+            }
+        }
+
+        uint32_t handle = pool->frozen ? ZUI_STRING_NONE : pool->freeHead;
+        ZuiStringEntry *entry = NULL;
+        if (handle != ZUI_STRING_NONE)
+        {
+            entry = (ZuiStringEntry *)ZuiGetDynArray(&pool->entries, handle - 1);
+            pool->freeHead = entry->nextFree;
+        }
+        else
+        {
+            entry = ZUI_DYNARRAY_PUSH_TYPE(&pool->entries, arena, ZuiStringEntry);
+            if (!entry)
+            {
+                return ZUI_STRING_NONE;
+            }
+            handle = pool->entries.count;
+        }
+
+        *entry = (ZuiStringEntry){
+            .offset = pool->bytes.count,
+            .length = (uint32_t)length,
+            .hash = hash,
+            .refs = 1,
+        };
+        memcpy((char *)pool->bytes.items + entry->offset, text, length + 1); /* Flawfinder: ignore */
+        pool->bytes.count += (uint32_t)length + 1;
+
+        if (tombstone != UINT32_MAX)
+        {
+            slots[tombstone] = handle;
+        }
+        else
+        {
+            ZuiInsertStringBucket(&pool->buckets, hash, handle);
+            pool->occupied++;
+        }
+        return handle;
+    }
+
+    void ZuiReleaseString(ZuiStringPool *pool, uint32_t handle)
+    {
+        if (!pool || handle == ZUI_STRING_NONE || handle > pool->entries.count || pool->frozen)
+        {
+            return;
+        }
+
+        ZuiStringEntry *entry = (ZuiStringEntry *)ZuiGetDynArray(&pool->entries, handle - 1);
+        if (entry->refs == 0 || --entry->refs > 0)
+        {
+            return;
+        }
+
+        const uint32_t *slots = (const uint32_t *)pool->buckets.items;
+        const uint32_t mask = pool->buckets.count - 1;
+        uint32_t slot = entry->hash & mask;
+        while (slots[slot] != handle)
+        {
+            slot = (slot + 1) & mask;
+        }
+        ZuiClearStringBucket(pool, slot);
+
+        pool->deadBytes += (size_t)entry->length + 1;
+        entry->nextFree = pool->freeHead;
+        pool->freeHead = handle;
+    }
+
+    const char *ZuiGetPooledString(const ZuiStringPool *pool, uint32_t handle)
+    {
+        if (!pool || handle == ZUI_STRING_NONE || handle > pool->entries.count)
+        {
+            return "";
+        }
+        const ZuiStringEntry *entry = (const ZuiStringEntry *)ZuiGetDynArray(&pool->entries, handle - 1);
+        return entry->refs > 0 ? (const char *)pool->bytes.items + entry->offset : "";
+    }
+
+    uint32_t ZuiGetPooledStringLength(const ZuiStringPool *pool, uint32_t handle)
+    {
+        if (!pool || handle == ZUI_STRING_NONE || handle > pool->entries.count)
+        {
+            return 0;
+        }
+        const ZuiStringEntry *entry = (const ZuiStringEntry *)ZuiGetDynArray(&pool->entries, handle - 1);
+        return entry->refs > 0 ? entry->length : 0;
+    }
+    // -----------------------------------------------------------------------------
+    // zui_component.c
+    // #include "zui_menu.h"
+    // #include "zui_window.h"
+
+    const ZuiComponentRegistration COMPONENT_TABLE[] = {
+        {
+            .name = "Transform",
+            .dataSize = sizeof(ZuiTransformData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiTransformData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Layout",
+            .dataSize = sizeof(ZuiLayoutData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiLayoutData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
+            .requiredComponentCount = 1,
+        },
+        {
+            .name = "Align",
+            .dataSize = sizeof(ZuiAlignData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiAlignData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Interaction",
+            .dataSize = sizeof(ZuiInteractionData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiInteractionData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
+            .requiredComponentCount = 1,
+        },
+        {
+            .name = "State",
+            .dataSize = sizeof(ZuiStateData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiStateData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Animation",
+            .dataSize = sizeof(ZuiAnimationData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiAnimationData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Focus",
+            .dataSize = sizeof(ZuiFocusData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiFocusData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Scroll",
+            .dataSize = sizeof(ZuiScrollData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiScrollData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
+            .requiredComponentCount = 1,
+        },
+        {
+            .name = "Layer",
+            .dataSize = sizeof(ZuiLayerData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiLayerData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+        {
+            .name = "Spatial",
+            .dataSize = sizeof(ZuiSpatialData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiSpatialData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+            .requiredComponents = COMPONENT_DEPS_TRANSFORM,
+            .requiredComponentCount = 1,
+        },
+        {
+            .name = "Grid",
+            .dataSize = sizeof(ZuiGridData),
+            .dataAlignment = ZUI_ALIGNOF(ZuiGridData),
+            .initialCapacity = ZUI_ITEMS_CAPACITY,
+        },
+    };
+
+    static uint32_t ZuiPopFreeIndex(ZuiDynArray *freeList)
+    {
+        // Slots released before a transient scope must survive its rollback
+        if (freeList->count == 0 || g_zui_ctx->transient.active)
+        {
+            return ZUI_ID_INVALID;
+        }
+        freeList->count--;
+        return ((const uint32_t *)freeList->items)[freeList->count];
+    }
+
+    static ZuiResult ZuiPushFreeIndex(ZuiDynArray *freeList, const uint32_t index, const char *typeName)
+    {
+        if (!freeList->items)
+        {
+            ZuiResult result = ZuiInitDynArray(freeList, &g_zui_arena, ZUI_ITEMS_CAPACITY,
+                                               sizeof(uint32_t), ZUI_ALIGNOF(uint32_t), typeName);
+            if (result != ZUI_OK)
+            {
+                return result;
+            }
+        }
+
+        uint32_t *slot = (uint32_t *)ZuiPushDynArray(freeList, &g_zui_arena);
+        if (!slot)
+        {
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+        *slot = index;
+        return ZUI_OK;
+    }
+
+    static ZuiResult ZuiSetIndexEntry(ZuiDynArray *table, const uint32_t slot, const uint32_t value, const char *typeName)
+    {
+        if (!table->items)
+        {
+            const uint32_t capacity = g_zui_ctx->config.itemCapacity > slot ? g_zui_ctx->config.itemCapacity : slot + 1;
+            ZuiResult result = ZuiInitDynArray(table, &g_zui_arena, capacity, sizeof(uint32_t),
+                                               ZUI_ALIGNOF(uint32_t), typeName);
+            if (result != ZUI_OK)
+            {
+                return result;
+            }
+        }
+
+        while (table->count <= slot)
+        {
+            uint32_t *entry = (uint32_t *)ZuiPushDynArray(table, &g_zui_arena);
+            if (!entry)
+            {
+                return ZUI_ERROR_OUT_OF_MEMORY;
+            }
+            *entry = 0;
+        }
+
+        ((uint32_t *)table->items)[slot] = value;
+        return ZUI_OK;
+    }
+
+    // Reuses a released slot when one is available, zeroed like a fresh push
+    static void *ZuiAllocSlotData(ZuiPagedArray *dataArray, ZuiDynArray *freeSlots, uint32_t *dataIndex)
+    {
+        uint32_t index = ZuiPopFreeIndex(freeSlots);
+        if (index != ZUI_ID_INVALID)
+        {
+            void *data = ZuiGetPagedArray(dataArray, index);
+            if (data)
+            {
+                memset(data, 0, dataArray->itemSize);
+                *dataIndex = index;
+            }
+            return data;
+        }
+
+        void *data = ZuiPushPagedArray(dataArray, &g_zui_arena);
+        if (data)
+        {
+            memset(data, 0, dataArray->itemSize); // pages may come from recycled arena blocks
+            *dataIndex = dataArray->count - 1;
+        }
+        return data;
+    }
+
+    // Swap-removes one component's data, repointing the item whose data moved into the hole
+    static void ZuiCompactComponentData(ZuiComponentRegistration *reg, const uint32_t dataIndex)
+    {
+        const uint32_t last = reg->dataArray.count - 1;
+        if (dataIndex != last && last < reg->owners.count)
+        {
+            const uint32_t movedId = ((const uint32_t *)reg->owners.items)[last];
+            ZuiItem *moved = ZuiGetItemMut(movedId);
+            if (moved)
+            {
+                for (uint32_t i = 0; i < moved->componentCount; i++)
+                {
+                    if (moved->components[i].componentId == reg->id)
+                    {
+                        moved->components[i].dataIndex = dataIndex;
+                    }
+                }
+            }
+            ((uint32_t *)reg->owners.items)[dataIndex] = movedId;
+            ZuiSetIndexEntry(&reg->sparse, movedId & ZUI_ID_INDEX_MASK, dataIndex + 1, "Sparse");
+        }
+
+        ZuiSwapRemovePagedArray(&reg->dataArray, dataIndex);
+        ZuiSetIndexEntry(&reg->owners, last, ZUI_ID_INVALID, "Owners");
+    }
+
+    // Detaches one component's data from its item. While something walks the dense arrays the slot only loses
+    // its owner, compacting it then would move an unvisited item behind the walk
+    static void ZuiReleaseComponentData(ZuiComponentRegistration *reg, const uint32_t dataIndex, const uint32_t slot)
+    {
+        ZuiDeferredRemoval *removal = NULL;
+        if (g_zui_ctx->iterationDepth > 0 && dataIndex < reg->owners.count)
+        {
+            if (g_zui_ctx->deferredRemovals.items ||
+                ZuiInitDynArray(&g_zui_ctx->deferredRemovals, &g_zui_arena, ZUI_ITEMS_CAPACITY,
+                                sizeof(ZuiDeferredRemoval), ZUI_ALIGNOF(ZuiDeferredRemoval),
+                                "DeferredRemovals") == ZUI_OK)
+            {
+                removal = ZUI_DYNARRAY_PUSH_TYPE(&g_zui_ctx->deferredRemovals, &g_zui_arena, ZuiDeferredRemoval);
+            }
+        }
+
+        if (removal)
+        {
+            *removal = (ZuiDeferredRemoval){.componentId = reg->id, .dataIndex = dataIndex};
+            ((uint32_t *)reg->owners.items)[dataIndex] = ZUI_ID_INVALID;
+        }
+        else
+        {
+            ZuiCompactComponentData(reg, dataIndex);
+        }
+        ZuiSetIndexEntry(&reg->sparse, slot, 0, "Sparse");
+    }
+
+    // Holes are filled from the tail, holes already at the tail are simply dropped
+    static void ZuiFlushComponentRemovals(void)
+    {
+        ZuiDynArray *pending = &g_zui_ctx->deferredRemovals;
+        for (uint32_t i = 0; i < pending->count; i++)
+        {
+            const ZuiDeferredRemoval removal = ((const ZuiDeferredRemoval *)pending->items)[i];
+            ZuiComponentRegistration *reg = ZuiGetComponentRegistration(removal.componentId);
+            if (!reg)
+            {
+                continue;
+            }
+
+            const uint32_t *owners = (const uint32_t *)reg->owners.items;
+            while (reg->dataArray.count > 0 && reg->dataArray.count <= reg->owners.count &&
+                   owners[reg->dataArray.count - 1] == ZUI_ID_INVALID)
+            {
+                ZuiSwapRemovePagedArray(&reg->dataArray, reg->dataArray.count - 1);
+            }
+            if (removal.dataIndex < reg->dataArray.count)
+            {
+                ZuiCompactComponentData(reg, removal.dataIndex);
+            }
+        }
+        pending->count = 0;
+    }
+
+    static void ZuiEndIteration(void)
+    {
+        if (g_zui_ctx->iterationDepth > 0 && --g_zui_ctx->iterationDepth == 0)
+        {
+            ZuiFlushComponentRemovals();
+        }
+    }
+
+    // True for items that existed when the active transient scope began, the rollback restores those
+    static bool ZuiIsPreScopeItem(const uint32_t id)
+    {
+        const ZuiTransientScope *scope = &g_zui_ctx->transient;
+        const uint32_t index = id & ZUI_ID_INDEX_MASK;
+        if (!scope->active || index >= scope->items.count)
+        {
+            return false;
+        }
+        const uint32_t *reused = (const uint32_t *)scope->reusedItems.items;
+        for (uint32_t i = 0; i < scope->reusedItems.count; i++)
+        {
+            if (reused[i] == index)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Pre-scope items cannot be destroyed inside a scope, so a pre-scope slot on the free list was free when it
+    // began. The first time the scope hands one out it is remembered, the rollback retires it past its generation
+    static uint32_t ZuiPopScopedItemSlot(void)
+    {
+        ZuiTransientScope *scope = &g_zui_ctx->transient;
+        ZuiDynArray *freeItems = &g_zui_ctx->freeItems;
+        if (freeItems->count == 0)
+        {
+            return ZUI_ID_INVALID;
+        }
+
+        const uint32_t index = ((const uint32_t *)freeItems->items)[--freeItems->count];
+        scope->freeLow = freeItems->count < scope->freeLow ? freeItems->count : scope->freeLow;
+        if (!ZuiIsPreScopeItem(index))
+        {
+            return index;
+        }
+
+        if (!scope->reusedItems.items &&
+            ZuiInitDynArray(&scope->reusedItems, &g_zui_arena, 64, sizeof(uint32_t), ZUI_ALIGNOF(uint32_t),
+                            "ReusedItems") != ZUI_OK)
+        {
+            return ZUI_ID_INVALID;
+        }
+        uint32_t *reused = (uint32_t *)ZuiPushDynArray(&scope->reusedItems, &g_zui_arena);
+        if (!reused)
+        {
+            return ZUI_ID_INVALID; // the slot stays dead, a fresh one is cheaper than an aliased id
+        }
+        *reused = index;
+        return index;
+    }
+
+    static void ZuiResetItemSlot(ZuiItem *item, const uint32_t generation)
+    {
+        *item = (ZuiItem){
+            .id = ZUI_ID_INVALID,
+            .parentId = ZUI_ID_INVALID,
+            .firstChild = ZUI_ID_INVALID,
+            .lastChild = ZUI_ID_INVALID,
+            .nextSibling = ZUI_ID_INVALID,
+            .prevSibling = ZUI_ID_INVALID,
+            .generation = generation,
+        };
+    }
+
+    static ZuiItem *ZuiAllocItemSlot(void)
+    {
+        uint32_t index = g_zui_ctx->transient.active ? ZuiPopScopedItemSlot() : ZuiPopFreeIndex(&g_zui_ctx->freeItems);
+        uint32_t generation = 0;
+        ZuiItem *item = NULL;
+
+        if (index != ZUI_ID_INVALID)
+        {
+            item = ZuiItemArrayGet(&g_zui_ctx->items, index);
+            if (!item)
+            {
+                return NULL;
+            }
+            generation = (item->generation + 1) & ZUI_ID_GENERATION_MASK;
+        }
+        else
+        {
+            if (g_zui_ctx->items.count > ZUI_ID_INDEX_MASK)
+            {
+                ZUI_REPORT_ERROR(ZUI_ERROR_OVERFLOW, "Item count exceeds %u id slots", ZUI_ID_INDEX_MASK + 1);
+                return NULL;
+            }
+            item = ZuiItemArrayPush(&g_zui_ctx->items, &g_zui_arena);
+            if (!item)
+            {
+                return NULL;
+            }
+            index = g_zui_ctx->items.count - 1;
+        }
+
+        uint32_t id = (generation << ZUI_ID_INDEX_BITS) | index;
+        if (id == ZUI_ID_INVALID)
+        {
+            generation = 0;
+            id = index;
+        }
+
+        *item = (ZuiItem){
+            .id = id,
+            .parentId = ZUI_ID_INVALID,
+            .firstChild = ZUI_ID_INVALID,
+            .lastChild = ZUI_ID_INVALID,
+            .nextSibling = ZUI_ID_INVALID,
+            .prevSibling = ZUI_ID_INVALID,
+            .generation = generation,
+            .dirtyFlags = ZUI_DIRTY_SELF,
+        };
+        return item;
+    }
+
+    // Splices child out of parent's sibling list, neighbours go through ZuiGetItemMut so scopes journal them
+    static void ZuiUnlinkChild(ZuiItem *parent, ZuiItem *child)
+    {
+        if (child->prevSibling != ZUI_ID_INVALID)
+        {
+            ZuiItem *prev = ZuiGetItemMut(child->prevSibling);
+            if (prev)
+            {
+                prev->nextSibling = child->nextSibling;
+            }
+        }
+        else
+        {
+            parent->firstChild = child->nextSibling;
+        }
+
+        if (child->nextSibling != ZUI_ID_INVALID)
+        {
+            ZuiItem *next = ZuiGetItemMut(child->nextSibling);
+            if (next)
+            {
+                next->prevSibling = child->prevSibling;
+            }
+        }
+        else
+        {
+            parent->lastChild = child->prevSibling;
+        }
+
+        child->nextSibling = ZUI_ID_INVALID;
+        child->prevSibling = ZUI_ID_INVALID;
+        parent->childCount--;
+    }
+
+    static void ZuiAppendChild(ZuiItem *parent, ZuiItem *child)
+    {
+        child->prevSibling = parent->lastChild;
+        child->nextSibling = ZUI_ID_INVALID;
+        if (parent->lastChild != ZUI_ID_INVALID)
+        {
+            ZuiItem *last = ZuiGetItemMut(parent->lastChild);
+            if (last)
+            {
+                last->nextSibling = child->id;
+            }
+        }
+        else
+        {
+            parent->firstChild = child->id;
+        }
+        parent->lastChild = child->id;
+        parent->childCount++;
+    }
+
+    // Walks address entries by index, a push may move the stack
+    static ZuiWalkEntry *ZuiWalkAt(uint32_t index)
+    {
+        return (ZuiWalkEntry *)g_zui_ctx->walkStack.items + index;
+    }
+
+    static bool ZuiPushWalk(uint32_t id, uint32_t parent, Rectangle rect)
+    {
+        ZuiDynArray *stack = &g_zui_ctx->walkStack;
+        if (!stack->items && ZuiInitDynArray(stack, &g_zui_arena, ZUI_ITEMS_CAPACITY, sizeof(ZuiWalkEntry),
+                                             ZUI_ALIGNOF(ZuiWalkEntry), "WalkStack") != ZUI_OK)
+        {
+            return false;
+        }
+        ZuiWalkEntry *entry = (ZuiWalkEntry *)ZuiPushDynArray(stack, &g_zui_arena);
+        if (!entry)
+        {
+            return false;
+        }
+        *entry = (ZuiWalkEntry){.id = id, .parent = parent, .rect = rect};
+        return true;
+    }
+
+    // Returns the base the walk pops down to, entries below it belong to an enclosing walk
+    static uint32_t ZuiBeginWalk(uint32_t rootId, Rectangle rect)
+    {
+        const uint32_t base = g_zui_ctx->walkStack.count;
+        ZuiPushWalk(rootId, ZUI_ID_INVALID, rect);
+        return base;
+    }
+
+    static void ZuiEndWalk(uint32_t base)
+    {
+        g_zui_ctx->walkStack.count = base;
+    }
+
+    static bool ZuiPopWalk(uint32_t base, ZuiWalkEntry *entry)
+    {
+        ZuiDynArray *stack = &g_zui_ctx->walkStack;
+        if (stack->count <= base)
+        {
+            return false;
+        }
+        *entry = *ZuiWalkAt(--stack->count);
+        return true;
+    }
+
+    // Last child first so siblings pop in order, links are read before any child is visited
+    static void ZuiPushWalkChildren(uint32_t id, uint32_t parent)
+    {
+        const ZuiItem *item = ZuiGetItem(id);
+        uint32_t childId = item ? item->lastChild : ZUI_ID_INVALID;
+        while (childId != ZUI_ID_INVALID && ZuiPushWalk(childId, parent, (Rectangle){0}))
+        {
+            const ZuiItem *child = ZuiGetItem(childId);
+            childId = child ? child->prevSibling : ZUI_ID_INVALID;
+        }
+    }
+
+    // Post-order, the entry goes back under its children and pops again once they are done
+    static void ZuiExpandWalk(ZuiWalkEntry entry, Rectangle rect)
+    {
+        const uint32_t index = g_zui_ctx->walkStack.count;
+        if (ZuiPushWalk(entry.id, entry.parent, rect))
+        {
+            ZuiWalkAt(index)->expanded = true;
+            ZuiPushWalkChildren(entry.id, index);
+        }
+    }
+
+    ZuiResult ZuiInitComponentRegistry(void)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
+        memset(&g_zui_ctx->componentRegistry, 0, sizeof(ZuiComponentRegistry));
+        ZuiResult result = ZuiInitPagedArray(&g_zui_ctx->componentRegistry.registrations, &g_zui_arena,
+                                             ZUI_COMPONENT_COUNT, sizeof(ZuiComponentRegistration),
+                                             ZUI_ALIGNOF(ZuiComponentRegistration), "ComponentRegistry");
+        if (result != ZUI_OK)
+        {
+            return result;
+        }
+
+        // Reserve the built-in ids so custom components always start at ZUI_COMPONENT_COUNT
+        for (uint32_t i = 0; i < ZUI_COMPONENT_COUNT; i++)
+        {
+            ZuiComponentRegistration *slot = ZuiPushPagedArray(&g_zui_ctx->componentRegistry.registrations, &g_zui_arena);
+            if (!slot)
+            {
+                return ZUI_ERROR_OUT_OF_MEMORY;
+            }
+            memset(slot, 0, sizeof(*slot));
+        }
+        TraceLog(LOG_INFO, "ZUI: Component registry initialized");
+        return ZUI_OK;
+    }
+
+    ZuiResult ZuiRegisterComponent(ZuiComponentId componentId, const ZuiComponentRegistration *info)
+    {
+        if (!g_zui_ctx || !info)
+        {
+            return ZUI_ERROR_NULL_POINTER;
+        }
+        ZuiComponentRegistry *reg = &g_zui_ctx->componentRegistry;
+        uint32_t idx = (uint32_t)componentId;
+        if (idx >= ZUI_COMPONENT_COUNT && idx != reg->registrations.count)
+        {
+            return ZUI_ERROR_INVALID_VALUE;
+        }
+
+        ZuiComponentRegistration *slot = idx < reg->registrations.count
+                                             ? ZuiComponentRegistrationPageAt(&reg->registrations, idx)
+                                             : ZuiPushPagedArray(&reg->registrations, &g_zui_arena);
+        if (!slot)
+        {
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+        memset(slot, 0, sizeof(*slot));
+
+        slot->name = info->name;
+        slot->dataSize = info->dataSize;
+        slot->dataAlignment = info->dataAlignment;
+        slot->initialCapacity = info->initialCapacity;
+        if (idx < ZUI_COMPONENT_COUNT && g_zui_ctx->config.componentCapacities[idx] > 0)
+        {
+            slot->initialCapacity = g_zui_ctx->config.componentCapacities[idx];
+        }
         slot->id = idx;
         uint32_t actualCapacity = slot->initialCapacity > 0 ? slot->initialCapacity : 32;
         if (actualCapacity > UINT32_MAX - 100)
         {
             actualCapacity = 32;
         }
-        ZuiResult result = ZuiInitDynArray(&slot->dataArray, &g_zui_arena,
-                                           actualCapacity, slot->dataSize,
-                                           slot->dataAlignment, slot->name);
+        ZuiResult result = ZuiInitPagedArray(&slot->dataArray, &g_zui_arena,
+                                             actualCapacity, slot->dataSize,
+                                             slot->dataAlignment, slot->name);
         slot->init = info->init;
+        slot->update = info->update;
         slot->requiredComponents = info->requiredComponents;
         slot->requiredComponentCount = info->requiredComponentCount;
         if (result != ZUI_OK)
@@ -1956,6 +3729,24 @@ extern "C"
         return ZUI_OK;
     }
 
+    // Appends a component after the built-ins and returns its runtime id, ZUI_ID_INVALID on failure
+    uint32_t ZuiRegisterCustomComponent(const ZuiComponentRegistration *info)
+    {
+        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
+        const uint32_t id = g_zui_ctx->componentRegistry.registrations.count;
+        const ZuiResult result = ZuiRegisterComponent((ZuiComponentId)id, info);
+        if (result != ZUI_OK)
+        {
+            ZUI_REPORT_ERROR(result, "Failed to register component '%s'", info && info->name ? info->name : "?");
+            return ZUI_ID_INVALID;
+        }
+        if (id >= ZUI_COMPONENT_MASK_BITS)
+        {
+            TraceLog(LOG_INFO, "ZUI: Component '%s' (%u) has no mask bit and cannot be queried", info->name, id);
+        }
+        return id;
+    }
+
     void ZuiRegisterAllComponents(void)
     {
         for (int i = 0; i < ZUI_COMPONENT_COUNT; i++)
@@ -1970,34 +3761,211 @@ extern "C"
         return component ? component : ZuiItemAddComponent(itemId, componentId);
     }
 
-    Vector2 ZuiGetAbsolutePosition(uint32_t itemId)
+    // Queues an item's hit-test lane for the next refresh, an unbounded backlog turns into a full rebuild
+    static void ZuiMarkLaneStale(uint32_t itemId)
+    {
+        ZuiWorldLanes *lanes = &g_zui_ctx->worldLanes;
+        if (lanes->rebuild)
+        {
+            return;
+        }
+        if (lanes->stale.count >= lanes->bounds.count ||
+            (!lanes->stale.items && ZuiInitDynArray(&lanes->stale, &g_zui_arena, ZUI_ITEMS_CAPACITY, sizeof(uint32_t),
+                                                    ZUI_ALIGNOF(uint32_t), "StaleLanes") != ZUI_OK))
+        {
+            lanes->rebuild = true;
+            return;
+        }
+        uint32_t *slot = (uint32_t *)ZuiPushDynArray(&lanes->stale, &g_zui_arena);
+        if (!slot)
+        {
+            lanes->rebuild = true;
+            return;
+        }
+        *slot = itemId;
+    }
+
+    // World caches resolve parents first, so a valid item has valid ancestors and the walk stops at the first invalid one
+    static void ZuiInvalidateSubtree(uint32_t itemId)
+    {
+        const uint32_t base = ZuiBeginWalk(itemId, (Rectangle){0});
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(entry.id, ZUI_COMPONENT_TRANSFORM);
+            if (t)
+            {
+                if (!t->worldValid)
+                {
+                    continue;
+                }
+                t->worldValid = false;
+                ZuiMarkLaneStale(entry.id);
+            }
+            ZuiPushWalkChildren(entry.id, ZUI_ID_INVALID);
+        }
+    }
+
+    static void ZuiInvalidateTransform(const ZuiTransformData *t)
+    {
+        if (t->worldValid)
+        {
+            ZuiInvalidateSubtree(t->itemId);
+        }
+    }
+
+    static void ZuiInvalidateWorldBounds(uint32_t itemId)
+    {
+        const ZuiTransformData *t = (const ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
+        if (t)
+        {
+            ZuiInvalidateTransform(t);
+        }
+    }
+
+    // Items without a transform are transparent, their children are placed from the next transformed ancestor
+    static ZuiTransformData *ZuiGetParentTransform(uint32_t itemId)
+    {
+        const ZuiItem *item = ZuiGetItem(itemId);
+        uint32_t parentId = item ? item->parentId : ZUI_ID_INVALID;
+        while (parentId != ZUI_ID_INVALID)
+        {
+            ZuiTransformData *parent = (ZuiTransformData *)ZuiItemGetComponent(parentId, ZUI_COMPONENT_TRANSFORM);
+            if (parent)
+            {
+                return parent;
+            }
+            const ZuiItem *ancestor = ZuiGetItem(parentId);
+            parentId = ancestor ? ancestor->parentId : ZUI_ID_INVALID;
+        }
+        return NULL;
+    }
+
+    // Layout keeps working in unscrolled positions, scroll containers only shift their descendants on screen
+    static void ZuiComputeWorldBounds(ZuiTransformData *t, const ZuiTransformData *parent)
     {
-        Vector2 position = {0, 0};
-        uint32_t currentId = itemId;
+        const Vector2 parentOrigin = parent ? parent->worldOrigin : (Vector2){0, 0};
+        const Vector2 parentShift = parent ? parent->scrollShift : (Vector2){0, 0};
+        t->worldOrigin = (Vector2){
+            parentOrigin.x + t->bounds.x + t->offset.x,
+            parentOrigin.y + t->bounds.y + t->offset.y};
+        Rectangle bounds = {t->worldOrigin.x - parentShift.x, t->worldOrigin.y - parentShift.y, t->bounds.width,
+                            t->bounds.height};
 
-        while (currentId != ZUI_ID_INVALID)
+        t->scrollShift = parentShift;
+        const ZuiScrollData *scroll = (const ZuiScrollData *)ZuiItemGetComponent(t->itemId, ZUI_COMPONENT_SCROLL);
+        if (scroll && (scroll->verticalEnabled || scroll->horizontalEnabled))
         {
-            Rectangle bounds = ZuiGetTransformBounds(currentId);
-            position.x += bounds.x;
-            position.y += bounds.y;
+            t->scrollShift.x += scroll->offset.x;
+            t->scrollShift.y += scroll->offset.y;
+        }
 
-            const ZuiItem *item = ZuiGetItem(currentId);
-            if (!item || item->parentId == ZUI_ID_INVALID)
+        const ZuiAnimationData *anim = (const ZuiAnimationData *)ZuiItemGetComponent(t->itemId, ZUI_COMPONENT_ANIMATION);
+        if (anim)
+        {
+            // Settled slots keep their value, like ZuiAnimGetValue, an unused scale slot reads 0
+            bounds.x += anim->slots[ZUI_ANIM_SLOT_OFFSET_X].value;
+            bounds.y += anim->slots[ZUI_ANIM_SLOT_OFFSET_Y].value;
+            const float scale = anim->slots[ZUI_ANIM_SLOT_SCALE].value;
+            if (scale > 0.0F && scale != 1.0F)
             {
-                break;
+                float center_x = bounds.x + (bounds.width * 0.5F);
+                float center_y = bounds.y + (bounds.height * 0.5F);
+                bounds.width *= scale;
+                bounds.height *= scale;
+                bounds.x = center_x - (bounds.width * 0.5F);
+                bounds.y = center_y - (bounds.height * 0.5F);
+            }
+        }
+        t->worldBounds = bounds;
+        t->worldValid = true;
+    }
+
+    // Stale ancestors are stacked and resolved outermost first, so each one reads a valid parent origin
+    static void ZuiResolveTransform(ZuiTransformData *t)
+    {
+        if (t->worldValid)
+        {
+            return;
+        }
+
+        const uint32_t base = g_zui_ctx->walkStack.count;
+        for (const ZuiTransformData *stale = t; stale && !stale->worldValid; stale = ZuiGetParentTransform(stale->itemId))
+        {
+            if (!ZuiPushWalk(stale->itemId, ZUI_ID_INVALID, (Rectangle){0}))
+            {
+                ZuiEndWalk(base);
+                return;
             }
-            currentId = item->parentId;
         }
-        return position;
+
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            ZuiComputeWorldBounds((ZuiTransformData *)ZuiItemGetComponent(entry.id, ZUI_COMPONENT_TRANSFORM),
+                                  ZuiGetParentTransform(entry.id));
+        }
+    }
+
+    static Vector2 ZuiGetParentOrigin(uint32_t itemId)
+    {
+        ZuiTransformData *parent = ZuiGetParentTransform(itemId);
+        if (!parent)
+        {
+            return (Vector2){0, 0};
+        }
+        ZuiResolveTransform(parent);
+        return parent->worldOrigin;
+    }
+
+    // Bounds are stored parent-relative, public setters take screen space
+    static Rectangle ZuiToLocalBounds(uint32_t itemId, Rectangle bounds)
+    {
+        const Vector2 parentOrigin = ZuiGetParentOrigin(itemId);
+        bounds.x -= parentOrigin.x;
+        bounds.y -= parentOrigin.y;
+        return bounds;
+    }
+
+    // Keeps an item where it was on screen when it moves to another parent
+    static void ZuiRebaseTransform(uint32_t itemId, Vector2 oldOrigin)
+    {
+        ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
+        if (t)
+        {
+            const Vector2 newOrigin = ZuiGetParentOrigin(itemId);
+            t->bounds.x += oldOrigin.x - newOrigin.x;
+            t->bounds.y += oldOrigin.y - newOrigin.y;
+        }
+        ZuiInvalidateSubtree(itemId);
+    }
+
+    // Screen rect as layout placed it, without offsets or animation, so re-arranging does not compound them
+    static Rectangle ZuiGetLayoutBounds(uint32_t itemId)
+    {
+        ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
+        if (!t)
+        {
+            return (Rectangle){0, 0, 0, 0};
+        }
+        ZuiResolveTransform(t);
+        return (Rectangle){t->worldOrigin.x - t->offset.x, t->worldOrigin.y - t->offset.y, t->bounds.width,
+                           t->bounds.height};
+    }
+
+    Vector2 ZuiGetAbsolutePosition(uint32_t itemId)
+    {
+        const Rectangle bounds = ZuiGetTransformBounds(itemId);
+        return (Vector2){bounds.x, bounds.y};
     }
 
     ZuiComponentRegistration *ZuiGetComponentRegistration(uint32_t componentId)
     {
-        if (!g_zui_ctx || componentId >= ZUI_COMPONENT_COUNT)
+        if (!g_zui_ctx || componentId >= g_zui_ctx->componentRegistry.registrations.count)
         {
             return NULL;
         }
-        return &g_zui_ctx->componentRegistry.registrations[componentId];
+        return ZuiComponentRegistrationPageAt(&g_zui_ctx->componentRegistry.registrations, componentId);
     }
 
     const ZuiComponentRegistration *ZuiGetComponentInfo(uint32_t componentId)
@@ -2014,6 +3982,7 @@ extern "C"
         info.dataAlignment = reg->dataAlignment;
         info.initialCapacity = reg->initialCapacity;
         info.init = reg->init;
+        info.update = reg->update;
         info.requiredComponents = reg->requiredComponents;
         info.requiredComponentCount = reg->requiredComponentCount;
         return &info;
@@ -2037,109 +4006,295 @@ extern "C"
         {
             if (!ZuiItemHasComponent(itemId, info->requiredComponents[i]))
             {
-                const ZuiComponentRegistration *reqInfo = ZuiGetComponentInfo(info->requiredComponents[i]);
+#ifdef ZUI_DEBUG
+                // Not ZuiGetComponentInfo, that would overwrite the static copy info points at
+                const ZuiComponentRegistration *required = ZuiGetComponentRegistration(info->requiredComponents[i]);
                 ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Component '%s' requires '%s' but item doesn't have it",
-                                 info->name, reqInfo ? reqInfo->name : "unknown");
+                                 info->name, required ? required->name : "unknown");
+#endif
                 return false;
             }
         }
-        return true;
+        return true;
+    }
+
+    // Ids past the mask width have no bit, so their sparse entry is confirmed against the owners table
+    static bool ZuiItemOwnsComponent(const ZuiItem *item, const ZuiComponentRegistration *reg)
+    {
+        if (reg->id < ZUI_COMPONENT_MASK_BITS)
+        {
+            return (item->componentMask & ZUI_COMPONENT_BIT(reg->id)) != 0;
+        }
+
+        const uint32_t index = item->id & ZUI_ID_INDEX_MASK;
+        const uint32_t dense = index < reg->sparse.count ? ((const uint32_t *)reg->sparse.items)[index] : 0;
+        return dense != 0 && dense - 1 < reg->dataArray.count && dense - 1 < reg->owners.count &&
+               ((const uint32_t *)reg->owners.items)[dense - 1] == item->id;
+    }
+
+    static void ZuiSetComponentBit(ZuiItem *item, const uint32_t componentId, const bool present)
+    {
+        if (componentId < ZUI_COMPONENT_MASK_BITS)
+        {
+            item->componentMask = present ? item->componentMask | ZUI_COMPONENT_BIT(componentId)
+                                          : item->componentMask & ~ZUI_COMPONENT_BIT(componentId);
+        }
+    }
+
+    void *ZuiItemAddComponent(uint32_t itemId, uint32_t componentId)
+    {
+        ZuiItem *item = ZuiGetItemMut(itemId);
+        if (!item)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Invalid item ID %u", itemId);
+            return NULL;
+        }
+
+        ZuiComponentRegistration *reg = ZuiGetComponentRegistration(componentId);
+        if (!reg)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Invalid component ID %u", componentId);
+            return NULL;
+        }
+
+        if (ZuiItemOwnsComponent(item, reg))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Item already has component '%s'", reg->name);
+            return ZuiItemGetComponent(itemId, componentId);
+        }
+
+        if (item->componentCount >= ZUI_ITEM_COMPONENTS_MAX)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OVERFLOW, "Item has max components (%d)", ZUI_ITEM_COMPONENTS_MAX);
+            return NULL;
+        }
+
+        if (!ZuiValidateComponentDependencies(itemId, componentId))
+        {
+            return NULL;
+        }
+
+        // Component data stays packed, new entries always go at the end
+        void *data = ZuiPushPagedArray(&reg->dataArray, &g_zui_arena);
+        if (!data)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate component data");
+            return NULL;
+        }
+        memset(data, 0, reg->dataSize);
+        const uint32_t dataIndex = reg->dataArray.count - 1;
+
+        if (ZuiSetIndexEntry(&reg->sparse, itemId & ZUI_ID_INDEX_MASK, dataIndex + 1, "Sparse") != ZUI_OK ||
+            ZuiSetIndexEntry(&reg->owners, dataIndex, itemId, "Owners") != ZUI_OK)
+        {
+            ZuiSwapRemovePagedArray(&reg->dataArray, dataIndex);
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to index component data");
+            return NULL;
+        }
+
+        item->components[item->componentCount++] = (ZuiItemComponent){.componentId = componentId, .dataIndex = dataIndex};
+        ZuiSetComponentBit(item, componentId, true);
+        if (componentId == ZUI_COMPONENT_TRANSFORM)
+        {
+            ZuiMarkLaneStale(itemId); // starts unresolved, like an invalidated transform
+        }
+
+        if (reg->init)
+        {
+            reg->init(data, itemId, componentId);
+        }
+
+#ifdef ZUI_DEBUG
+        TraceLog(LOG_DEBUG, "ZUI: Added component '%s' to item %u", reg->name, itemId);
+#endif
+        return data;
+    }
+
+    void *ZuiItemGetComponent(uint32_t itemId, uint32_t componentId)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL") ||
+            componentId >= g_zui_ctx->componentRegistry.registrations.count)
+        {
+            return NULL;
+        }
+
+        const uint32_t index = itemId & ZUI_ID_INDEX_MASK;
+        const ZuiItem *item = ZuiItemArrayGet(&g_zui_ctx->items, index);
+        if (!item || item->id != itemId)
+        {
+            ZuiGetItem(itemId); // reports the stale or out of range id
+            return NULL;
+        }
+
+        // The mask also covers entries left behind by a transient scope rollback, and skips the registry load
+        const bool masked = componentId < ZUI_COMPONENT_MASK_BITS;
+        if (masked && !(item->componentMask & ZUI_COMPONENT_BIT(componentId)))
+        {
+            return NULL;
+        }
+
+        const ZuiComponentRegistration *reg = ZuiComponentRegistrationPageAt(&g_zui_ctx->componentRegistry.registrations, componentId);
+        const uint32_t dense = index < reg->sparse.count ? ((const uint32_t *)reg->sparse.items)[index] : 0;
+        if (dense == 0 || (!masked && !ZuiItemOwnsComponent(item, reg)))
+        {
+            return NULL;
+        }
+        return ZuiPagedArrayAt(&reg->dataArray, dense - 1);
     }
 
-    void *ZuiItemAddComponent(uint32_t itemId, uint32_t componentId)
+    ZuiResult ZuiItemRemoveComponent(uint32_t itemId, uint32_t componentId)
     {
         ZuiItem *item = ZuiGetItemMut(itemId);
-        if (!item)
+        ZuiComponentRegistration *reg = ZuiGetComponentRegistration(componentId);
+        if (!item || !reg)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Invalid item ID %u", itemId);
-            return NULL;
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Invalid item %u or component %u", itemId, componentId);
+            return ZUI_ERROR_INVALID_ID;
         }
 
-        ZuiComponentRegistration *reg = ZuiGetComponentRegistration(componentId);
-        if (!reg)
+        if (!ZuiItemOwnsComponent(item, reg))
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Invalid component ID %u", componentId);
-            return NULL;
+            return ZUI_ERROR_ITEM_NOT_FOUND;
         }
 
-        if (item->componentMask & ((uint32_t)1 << componentId))
+        for (uint32_t i = 0; i < item->componentCount; i++)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Item already has component '%s'", reg->name);
-            return ZuiItemGetComponent(itemId, componentId);
+            const ZuiComponentRegistration *other = ZuiGetComponentInfo(item->components[i].componentId);
+            for (uint32_t j = 0; other && j < other->requiredComponentCount; j++)
+            {
+                if (other->requiredComponents[j] == componentId)
+                {
+                    ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Component '%s' is required by '%s'", reg->name,
+                                     other->name);
+                    return ZUI_ERROR_INVALID_STATE;
+                }
+            }
         }
 
-        if (item->componentCount >= ZUI_COMPONENT_TYPES)
+        // Swapping would move data the scope cannot put back
+        if (ZuiIsPreScopeItem(itemId))
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OVERFLOW, "Item has max components (%d)", ZUI_COMPONENT_TYPES);
-            return NULL;
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Item %u was created before the transient scope", itemId);
+            return ZUI_ERROR_INVALID_STATE;
         }
 
-        if (!ZuiValidateComponentDependencies(itemId, componentId))
+        for (uint32_t i = 0; i < item->componentCount; i++)
         {
-            return NULL;
+            if (item->components[i].componentId == componentId)
+            {
+                const uint32_t dataIndex = item->components[i].dataIndex;
+                item->components[i] = item->components[--item->componentCount];
+                ZuiSetComponentBit(item, componentId, false);
+                ZuiReleaseComponentData(reg, dataIndex, itemId & ZUI_ID_INDEX_MASK);
+                if (componentId == ZUI_COMPONENT_ANIMATION || componentId == ZUI_COMPONENT_SCROLL)
+                {
+                    ZuiInvalidateWorldBounds(itemId);
+                }
+                break;
+            }
         }
+        return ZUI_OK;
+    }
 
-        void *data = ZuiPushDynArray(&reg->dataArray, &g_zui_arena);
-        if (!data)
+    ZuiQuery ZuiQueryBegin(const uint32_t mask)
+    {
+        ZuiQuery query = {.mask = mask, .driver = ZUI_ID_INVALID, .itemId = ZUI_ID_INVALID};
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate component data");
-            return NULL;
+            return query;
         }
 
-        uint32_t dataIndex = reg->dataArray.count - 1;
-        item->components[item->componentCount++] = (ZuiItemComponent){.componentId = componentId, .dataIndex = dataIndex};
-        item->componentMask |= ((uint32_t)1 << componentId);
+        uint32_t fewest = UINT32_MAX;
+        for (uint32_t i = 0; i < ZUI_COMPONENT_MASK_BITS; i++)
+        {
+            if (!(mask & ZUI_COMPONENT_BIT(i)))
+            {
+                continue;
+            }
+            const ZuiComponentRegistration *reg = ZuiGetComponentRegistration(i);
+            if (!reg)
+            {
+                query.driver = ZUI_ID_INVALID; // an unregistered component matches nothing
+                break;
+            }
+            if (reg->dataArray.count < fewest)
+            {
+                fewest = reg->dataArray.count;
+                query.driver = i;
+            }
+        }
 
-        if (reg->init)
+        if (query.driver != ZUI_ID_INVALID)
         {
-            reg->init(data, itemId, componentId);
+            query.open = true;
+            g_zui_ctx->iterationDepth++;
         }
+        return query;
+    }
 
-#ifdef ZUI_DEBUG
-        TraceLog(LOG_DEBUG, "ZUI: Added component '%s' to item %u", reg->name, itemId);
-#endif
-        return data;
+    void ZuiQueryEnd(ZuiQuery *query)
+    {
+        if (query && query->open && g_zui_ctx)
+        {
+            query->open = false;
+            ZuiEndIteration();
+        }
     }
 
-    void *ZuiItemGetComponent(uint32_t itemId, uint32_t componentId)
+    bool ZuiQueryNext(ZuiQuery *query)
     {
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item || !(item->componentMask & ((uint32_t)1U << componentId)))
+        const ZuiComponentRegistration *driver = query ? ZuiGetComponentRegistration(query->driver) : NULL;
+        if (!driver)
         {
-            return NULL;
+            return false;
         }
 
-        for (uint32_t i = 0; i < item->componentCount; i++)
+        // Re-read the registration each step, callbacks may add components mid-walk. Removals only leave
+        // ownerless holes until the query ends, so nothing moves under the cursor
+        while (query->open && query->cursor < driver->dataArray.count && query->cursor < driver->owners.count)
         {
-            if (item->components[i].componentId == componentId)
+            const uint32_t dense = query->cursor++;
+            const uint32_t itemId = ((const uint32_t *)driver->owners.items)[dense];
+            const uint32_t index = itemId & ZUI_ID_INDEX_MASK;
+            const ZuiItem *item = itemId != ZUI_ID_INVALID ? ZuiItemArrayGet(&g_zui_ctx->items, index) : NULL;
+
+            // Holes and an owner table out of step with the item are skipped
+            if (!item || item->id != itemId || (item->componentMask & query->mask) != query->mask ||
+                index >= driver->sparse.count || ((const uint32_t *)driver->sparse.items)[index] != dense + 1)
             {
-                ZuiComponentRegistration *reg = ZuiGetComponentRegistration(componentId);
-                if (!reg)
-                {
-                    return NULL;
-                }
+                continue;
+            }
 
-                uint32_t dataIndex = item->components[i].dataIndex;
-                if (dataIndex >= reg->dataArray.count)
+            query->index = dense;
+            query->itemId = itemId;
+            // Slots outside the mask stay NULL from ZuiQueryBegin
+            uint32_t bits = query->mask;
+            for (uint32_t i = 0; bits != 0; i++, bits >>= 1U)
+            {
+                if (bits & 1U)
                 {
-                    ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_BOUNDS, "Component data index out of bounds");
-                    return NULL;
+                    query->components[i] = i == query->driver ? ZuiPagedArrayAt(&driver->dataArray, dense)
+                                                              : ZuiItemGetComponent(itemId, i);
                 }
-                return ZuiGetDynArray(&reg->dataArray, dataIndex);
             }
+            return true;
         }
-        return NULL;
+
+        query->itemId = ZUI_ID_INVALID;
+        ZuiQueryEnd(query);
+        return false;
     }
 
     bool ZuiItemHasComponent(uint32_t itemId, uint32_t componentId)
     {
         const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item)
+        const ZuiComponentRegistration *reg = ZuiGetComponentRegistration(componentId);
+        if (!item || !reg)
         {
             return false;
         }
 
-        return (item->componentMask & ((uint32_t)1 << componentId)) != 0;
+        return ZuiItemOwnsComponent(item, reg);
     }
 
     //--------------------------------------------------------TRANSFORM
@@ -2154,25 +4309,37 @@ extern "C"
             return ZUI_ID_INVALID;
         }
         t->itemId = itemId;
-        t->bounds = bounds;
+        t->bounds = ZuiToLocalBounds(itemId, bounds);
         return 0;
     }
 
     void ZuiSetTransformBounds(uint32_t itemId, Rectangle bounds)
     {
         ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
-        if (t)
+        if (!t)
+        {
+            return;
+        }
+
+        // Render re-centres button content every frame, rewriting the same rect must not dirty anything
+        bounds = ZuiToLocalBounds(itemId, bounds);
+        if (t->bounds.x != bounds.x || t->bounds.y != bounds.y || t->bounds.width != bounds.width ||
+            t->bounds.height != bounds.height)
         {
             t->bounds = bounds;
+            ZuiInvalidateTransform(t);
+            ZuiMarkDirty(itemId);
         }
     }
 
     void ZuiSetTransformOffset(uint32_t itemId, Vector2 offset)
     {
         ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
-        if (t)
+        if (t && (t->offset.x != offset.x || t->offset.y != offset.y))
         {
             t->offset = offset;
+            ZuiInvalidateTransform(t);
+            ZuiMarkDirty(itemId);
         }
     }
 
@@ -2183,47 +4350,131 @@ extern "C"
         {
             t->bounds.x += offset.x;
             t->bounds.y += offset.y;
+            ZuiInvalidateTransform(t);
+            ZuiMarkDirty(itemId);
         }
     }
 
     Rectangle ZuiGetTransformBounds(uint32_t itemId)
     {
-        const ZuiTransformData *t = (const ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
+        ZuiTransformData *t = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
         if (!t)
         {
             return (Rectangle){0, 0, 0, 0};
         }
+        if (!t->worldValid)
+        {
+            ZuiResolveTransform(t);
+        }
+        return t->worldBounds;
+    }
 
-        Rectangle bounds = t->bounds;
-        bounds.x += t->offset.x;
-        bounds.y += t->offset.y;
+    ZuiResult ZuiInitBoundsSoA(ZuiBoundsSoA *soa, ZuiArena *arena, const uint32_t count)
+    {
+        if (!soa || !arena)
+        {
+            return ZUI_ERROR_NULL_POINTER;
+        }
 
-        const ZuiAnimationData *anim = (const ZuiAnimationData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_ANIMATION);
-        if (anim)
+        *soa = (ZuiBoundsSoA){0};
+        const uint32_t padded = (count + 7U) & ~7U;
+        if (padded == 0)
         {
-            if (anim->slots[ZUI_ANIM_SLOT_OFFSET_X].active)
+            return ZUI_OK;
+        }
+
+        float **lanes[] = {&soa->x, &soa->y, &soa->width, &soa->height};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            *lanes[i] = (float *)ZuiAllocArena(arena, sizeof(float) * padded, 32);
+            if (!*lanes[i])
+            {
+                *soa = (ZuiBoundsSoA){0};
+                return ZUI_ERROR_OUT_OF_MEMORY;
+            }
+            memset(*lanes[i], 0, sizeof(float) * padded);
+        }
+        soa->count = padded;
+        return ZUI_OK;
+    }
+
+    void ZuiSetBoundsSoA(ZuiBoundsSoA *soa, const uint32_t index, const Rectangle bounds)
+    {
+        if (soa && index < soa->count)
+        {
+            soa->x[index] = bounds.x;
+            soa->y[index] = bounds.y;
+            soa->width[index] = bounds.width;
+            soa->height[index] = bounds.height;
+        }
+    }
+
+    // Same edges as CheckCollisionPointRec: left/top inclusive, right/bottom exclusive
+    void ZuiHitTestBatch(const ZuiBoundsSoA *soa, const Vector2 point, uint8_t *hitMasks)
+    {
+        if (!soa || !hitMasks)
+        {
+            return;
+        }
+
+        for (uint32_t base = 0; base < soa->count; base += 8)
+        {
+            uint32_t mask = 0;
+#if defined(ZUI_SIMD_AVX)
+            const __m256 px = _mm256_set1_ps(point.x);
+            const __m256 py = _mm256_set1_ps(point.y);
+            const __m256 x = _mm256_loadu_ps(soa->x + base);
+            const __m256 y = _mm256_loadu_ps(soa->y + base);
+            __m256 inside = _mm256_and_ps(_mm256_cmp_ps(px, x, _CMP_GE_OQ),
+                                          _mm256_cmp_ps(px, _mm256_add_ps(x, _mm256_loadu_ps(soa->width + base)), _CMP_LT_OQ));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(py, y, _CMP_GE_OQ));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(py, _mm256_add_ps(y, _mm256_loadu_ps(soa->height + base)), _CMP_LT_OQ));
+            mask = (uint32_t)_mm256_movemask_ps(inside);
+#elif defined(ZUI_SIMD_SSE)
+            const __m128 px = _mm_set1_ps(point.x);
+            const __m128 py = _mm_set1_ps(point.y);
+            for (uint32_t half = 0; half < 8; half += 4)
             {
-                bounds.x += anim->slots[ZUI_ANIM_SLOT_OFFSET_X].value;
+                const __m128 x = _mm_loadu_ps(soa->x + base + half);
+                const __m128 y = _mm_loadu_ps(soa->y + base + half);
+                __m128 inside = _mm_and_ps(_mm_cmpge_ps(px, x),
+                                           _mm_cmplt_ps(px, _mm_add_ps(x, _mm_loadu_ps(soa->width + base + half))));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(py, y));
+                inside = _mm_and_ps(inside, _mm_cmplt_ps(py, _mm_add_ps(y, _mm_loadu_ps(soa->height + base + half))));
+                mask |= (uint32_t)_mm_movemask_ps(inside) << half;
             }
-            if (anim->slots[ZUI_ANIM_SLOT_OFFSET_Y].active)
+#elif defined(ZUI_SIMD_NEON)
+            static const uint32_t laneBits[4] = {1, 2, 4, 8};
+            const float32x4_t px = vdupq_n_f32(point.x);
+            const float32x4_t py = vdupq_n_f32(point.y);
+            for (uint32_t half = 0; half < 8; half += 4)
             {
-                bounds.y += anim->slots[ZUI_ANIM_SLOT_OFFSET_Y].value;
+                const float32x4_t x = vld1q_f32(soa->x + base + half);
+                const float32x4_t y = vld1q_f32(soa->y + base + half);
+                uint32x4_t inside = vandq_u32(vcgeq_f32(px, x),
+                                              vcltq_f32(px, vaddq_f32(x, vld1q_f32(soa->width + base + half))));
+                inside = vandq_u32(inside, vcgeq_f32(py, y));
+                inside = vandq_u32(inside, vcltq_f32(py, vaddq_f32(y, vld1q_f32(soa->height + base + half))));
+                mask |= vaddvq_u32(vandq_u32(inside, vld1q_u32(laneBits))) << half;
             }
-            if (anim->slots[ZUI_ANIM_SLOT_SCALE].active)
+#else
+            for (uint32_t lane = 0; lane < 8; lane++)
             {
-                float scale = anim->slots[ZUI_ANIM_SLOT_SCALE].value;
-                if (scale != 1.0F)
+                const uint32_t i = base + lane;
+                if (point.x >= soa->x[i] && point.x < soa->x[i] + soa->width[i] &&
+                    point.y >= soa->y[i] && point.y < soa->y[i] + soa->height[i])
                 {
-                    float center_x = bounds.x + (bounds.width * 0.5F);
-                    float center_y = bounds.y + (bounds.height * 0.5F);
-                    bounds.width *= scale;
-                    bounds.height *= scale;
-                    bounds.x = center_x - (bounds.width * 0.5F);
-                    bounds.y = center_y - (bounds.height * 0.5F);
+                    mask |= 1U << lane;
                 }
             }
+#endif
+            hitMasks[base >> 3] = (uint8_t)mask;
         }
-        return bounds;
+    }
+
+    bool ZuiBoundsSoAHit(const uint8_t *hitMasks, const uint32_t index)
+    {
+        return (hitMasks[index >> 3] >> (index & 7U)) & 1U;
     }
 
     //-------------------------------------------------------- LAYOUT
@@ -2244,81 +4495,409 @@ extern "C"
             a->widthMode = ZUI_SIZE_AUTO;
             a->heightMode = ZUI_SIZE_AUTO;
             a->margin = 0.0F;
+            a->columnSpan = 1;
+            a->rowSpan = 1;
         }
         return a;
     }
 
-    static Vector2 ZuiMeasureWidget(uint32_t itemId)
-    {
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item)
-        {
-            return (Vector2){0, 0};
-        }
+    // The fields are public, so spans are clamped again where the records are filled
+    static uint32_t ZuiClampGridSpan(uint32_t span)
+    {
+        return span == 0 ? 1U : (span > ZUI_GRID_MAX_SPAN ? ZUI_GRID_MAX_SPAN : span);
+    }
+
+    static ZuiMeasureEntry *ZuiMeasureChild(uint32_t itemId, ZuiMeasureEntry *entry)
+    {
+        *entry = (ZuiMeasureEntry){.columnSpan = 1, .rowSpan = 1};
+        const ZuiItem *item = ZuiGetItem(itemId);
+        if (!item)
+        {
+            return entry;
+        }
+
+        const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_ALIGN);
+        if (a)
+        {
+            entry->margin = a->margin;
+            entry->align = a->align;
+            entry->fillWidth = a->widthMode == ZUI_SIZE_FILL;
+            entry->fillHeight = a->heightMode == ZUI_SIZE_FILL;
+            entry->columnSpan = ZuiClampGridSpan(a->columnSpan);
+            entry->rowSpan = ZuiClampGridSpan(a->rowSpan);
+            if (a->widthMode == ZUI_SIZE_FIXED && a->heightMode == ZUI_SIZE_FIXED)
+            {
+                entry->size = (Vector2){a->fixedWidth, a->fixedHeight};
+                return entry;
+            }
+        }
+
+        const ZuiLayoutData *l = item->type == ZUI_FRAME
+                                     ? (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT)
+                                     : NULL;
+        if (l)
+        {
+            entry->size = (Vector2){l->measuredWidth, l->measuredHeight};
+        }
+        else
+        {
+            Rectangle bounds = ZuiGetTransformBounds(itemId);
+            entry->size = (Vector2){bounds.width, bounds.height};
+        }
+
+        if (a)
+        {
+            if (a->widthMode == ZUI_SIZE_FIXED)
+            {
+                entry->size.x = a->fixedWidth;
+            }
+            if (a->heightMode == ZUI_SIZE_FIXED)
+            {
+                entry->size.y = a->fixedHeight;
+            }
+        }
+        return entry;
+    }
+
+    // Measure records live in the frame arena and are only trusted inside the pass that wrote them
+    static void ZuiBeginLayoutPass(void)
+    {
+        g_zui_ctx->layoutPassMarker = ZuiArenaMark(&g_zui_ctx->frameArena);
+        g_zui_ctx->layoutPass = ++g_zui_ctx->layoutPassSerial;
+        if (g_zui_ctx->layoutPass == 0)
+        {
+            g_zui_ctx->layoutPass = ++g_zui_ctx->layoutPassSerial;
+        }
+    }
+
+    static void ZuiEndLayoutPass(void)
+    {
+        g_zui_ctx->layoutPass = 0;
+        ZuiArenaRestore(&g_zui_ctx->frameArena, g_zui_ctx->layoutPassMarker);
+    }
+
+    // Records from the current pass, NULL when arrange has to measure for itself
+    static ZuiMeasureEntry *ZuiGetMeasureEntries(const ZuiLayoutData *layout)
+    {
+        if (layout->measurePass == 0 || layout->measurePass != g_zui_ctx->layoutPass)
+        {
+            return NULL;
+        }
+        return (ZuiMeasureEntry *)(void *)(g_zui_ctx->frameArena.buffer + layout->measureOffset);
+    }
+
+    static ZuiLayoutData *ZuiGetActiveLayout(uint32_t itemId)
+    {
+        ZuiLayoutData *layout = (ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
+        return layout && layout->kind != ZUI_LAYOUT_NONE ? layout : NULL;
+    }
+
+    // Content width a wrap layout breaks lines at, FLT_MAX keeps everything on one line
+    static float ZuiGetWrapWidth(const ZuiItem *item, const ZuiLayoutData *layout)
+    {
+        const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(item->id, ZUI_COMPONENT_ALIGN);
+        const ZuiLayoutData *parent = item->parentId != ZUI_ID_INVALID ? ZuiGetActiveLayout(item->parentId) : NULL;
+
+        // Auto widths follow the content, any other width is whatever arrange handed out last
+        const bool constrained = parent && parent->isFinalized ? a && a->widthMode != ZUI_SIZE_AUTO
+                                                               : !(layout->isFinalized && layout->hugWidth);
+        float width = 0.0F;
+        if (constrained && !layout->isFinalized && a && a->widthMode == ZUI_SIZE_FIXED)
+        {
+            width = a->fixedWidth;
+        }
+        else if (constrained)
+        {
+            const ZuiTransformData *t = (const ZuiTransformData *)ZuiItemGetComponent(item->id, ZUI_COMPONENT_TRANSFORM);
+            width = t ? t->bounds.width : 0.0F;
+        }
+        return width > 0.0F ? fmaxf(0.0F, width - (layout->padding * 2.0F)) : FLT_MAX;
+    }
+
+    static bool ZuiWrapBreaks(uint32_t lineCount, float lineWidth, float childWidth, float spacing, float maxWidth)
+    {
+        return lineCount > 0 && lineWidth + spacing + childWidth > maxWidth + ZUI_WRAP_TOLERANCE;
+    }
+
+    static void ZuiMeasureWrap(const ZuiItem *item, ZuiLayoutData *layout, ZuiMeasureEntry *entries)
+    {
+        const float maxWidth = ZuiGetWrapWidth(item, layout);
+        float width = 0.0F;
+        float height = 0.0F;
+        float lineWidth = 0.0F;
+        float lineHeight = 0.0F;
+        uint32_t lineCount = 0;
+
+        uint32_t index = 0;
+        for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
+        {
+            ZuiMeasureEntry local;
+            const ZuiMeasureEntry *e = ZuiMeasureChild(childId, entries ? &entries[index++] : &local);
+            const float childWidth = e->size.x + (e->margin * 2.0F);
+            if (ZuiWrapBreaks(lineCount, lineWidth, childWidth, layout->spacing, maxWidth))
+            {
+                width = fmaxf(width, lineWidth);
+                height += lineHeight + layout->spacing;
+                lineWidth = 0.0F;
+                lineHeight = 0.0F;
+                lineCount = 0;
+            }
+            lineWidth += (lineCount > 0 ? layout->spacing : 0.0F) + childWidth;
+            lineHeight = fmaxf(lineHeight, e->size.y + (e->margin * 2.0F));
+            lineCount++;
+        }
+
+        layout->measuredWidth = fmaxf(width, lineWidth) + (layout->padding * 2.0F);
+        layout->measuredHeight = height + lineHeight + (layout->padding * 2.0F);
+    }
+
+    // Grids without explicit tracks read as a single auto column with auto rows
+    static const ZuiGridData *ZuiGetGridData(uint32_t itemId)
+    {
+        static const ZuiGridData none = {0};
+        const ZuiGridData *grid = (const ZuiGridData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_GRID);
+        return grid ? grid : &none;
+    }
+
+    static uint32_t ZuiGetGridColumnCount(const ZuiGridData *grid)
+    {
+        return grid->columnCount > 0 ? grid->columnCount : 1U;
+    }
+
+    static ZuiGridTrack ZuiGetGridTrack(const ZuiGridTrack *tracks, uint32_t trackCount, uint32_t index)
+    {
+        return index < trackCount ? tracks[index] : (ZuiGridTrack){ZUI_SIZE_AUTO, 0.0F};
+    }
+
+    // A child spanning several tracks widens the non-fixed ones evenly by whatever it is still missing
+    static void ZuiSpreadGridSpan(const ZuiGridTrack *tracks, uint32_t trackCount, float *sizes, uint32_t first,
+                                  uint32_t span, float needed, float spacing)
+    {
+        float current = spacing * (float)(span - 1);
+        uint32_t flexible = 0;
+        for (uint32_t i = first; i < first + span; i++)
+        {
+            current += sizes[i];
+            flexible += ZuiGetGridTrack(tracks, trackCount, i).mode != ZUI_SIZE_FIXED ? 1U : 0U;
+        }
+        if (needed <= current || flexible == 0)
+        {
+            return;
+        }
+
+        const float share = (needed - current) / (float)flexible;
+        for (uint32_t i = first; i < first + span; i++)
+        {
+            if (ZuiGetGridTrack(tracks, trackCount, i).mode != ZUI_SIZE_FIXED)
+            {
+                sizes[i] += share;
+            }
+        }
+    }
+
+    // Fill tracks split what the other tracks leave of available by weight, a negative available sizes them
+    // so every fill track still fits its content. Returns the extent of all tracks and the spacing between them
+    static float ZuiResolveGridTracks(const ZuiGridTrack *tracks, uint32_t trackCount, float *sizes, uint32_t count,
+                                      float spacing, float available)
+    {
+        float used = count > 1 ? spacing * (float)(count - 1) : 0.0F;
+        float weights = 0.0F;
+        float fillScale = 0.0F; // content per unit of weight
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const ZuiGridTrack track = ZuiGetGridTrack(tracks, trackCount, i);
+            if (track.mode == ZUI_SIZE_FILL)
+            {
+                const float weight = fmaxf(track.size, 0.0F);
+                weights += weight;
+                fillScale = weight > 0.0F ? fmaxf(fillScale, sizes[i] / weight) : fillScale;
+            }
+            else
+            {
+                used += sizes[i];
+            }
+        }
+        if (weights <= 0.0F)
+        {
+            return used;
+        }
+
+        const float fillTotal = available < 0.0F ? fillScale * weights : fmaxf(0.0F, available - used);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const ZuiGridTrack track = ZuiGetGridTrack(tracks, trackCount, i);
+            if (track.mode == ZUI_SIZE_FILL)
+            {
+                sizes[i] = fillTotal * fmaxf(track.size, 0.0F) / weights;
+            }
+        }
+        return used + fillTotal;
+    }
+
+    // Auto-places the children row by row and sizes the tracks from their records. The child list is walked
+    // once, spans are settled afterwards from the flat records. Sizes come back in the frame arena
+    static bool ZuiSolveGrid(const ZuiItem *item, const ZuiLayoutData *layout, const ZuiGridData *grid,
+                             ZuiMeasureEntry *entries, bool measure, float **columnSizes, float **rowSizes,
+                             uint32_t *rowCount)
+    {
+        const uint32_t columnCount = ZuiGetGridColumnCount(grid);
+        float *columns = ZUI_FRAME_ALLOC_ARRAY(float, columnCount);
+        uint32_t *freeRow = ZUI_FRAME_ALLOC_ARRAY(uint32_t, columnCount); // first row a column is free again
+        if (!columns || !freeRow)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < columnCount; i++)
+        {
+            const ZuiGridTrack track = ZuiGetGridTrack(grid->columns, grid->columnCount, i);
+            columns[i] = track.mode == ZUI_SIZE_FIXED ? track.size : 0.0F;
+            freeRow[i] = 0;
+        }
+
+        uint32_t rows = grid->rowCount;
+        uint32_t row = 0;
+        uint32_t column = 0;
+        bool rowSpans = false;
+        uint32_t index = 0;
+        for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
+        {
+            ZuiMeasureEntry *e = measure ? ZuiMeasureChild(childId, &entries[index]) : &entries[index];
+            index++;
+            const uint32_t span = e->columnSpan < columnCount ? e->columnSpan : columnCount;
+            for (;;)
+            {
+                if (column + span > columnCount)
+                {
+                    row++;
+                    column = 0;
+                    continue;
+                }
+                uint32_t blocked = column + span;
+                for (uint32_t i = column; i < column + span; i++)
+                {
+                    if (freeRow[i] > row)
+                    {
+                        blocked = i;
+                        break;
+                    }
+                }
+                if (blocked == column + span)
+                {
+                    break;
+                }
+                column = blocked + 1;
+            }
+
+            e->column = column;
+            e->row = row;
+            const uint32_t end = e->rowSpan < UINT32_MAX - row ? row + e->rowSpan : UINT32_MAX;
+            for (uint32_t i = column; i < column + span; i++)
+            {
+                freeRow[i] = end;
+            }
+            rows = end > rows ? end : rows;
+            rowSpans = rowSpans || e->rowSpan > 1;
 
-        const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_ALIGN);
-        if (a && a->widthMode == ZUI_SIZE_FIXED && a->heightMode == ZUI_SIZE_FIXED)
-        {
-            return (Vector2){a->fixedWidth, a->fixedHeight};
+            if (span == 1 && ZuiGetGridTrack(grid->columns, grid->columnCount, column).mode != ZUI_SIZE_FIXED)
+            {
+                columns[column] = fmaxf(columns[column], e->size.x + (e->margin * 2.0F));
+            }
+            column += span;
         }
 
-        Vector2 size = {0};
-        if (item->type == ZUI_FRAME && ZuiItemHasComponent(itemId, ZUI_COMPONENT_LAYOUT))
+        float *rowsOut = ZUI_FRAME_ALLOC_ARRAY(float, rows);
+        if (!rowsOut)
         {
-            const ZuiLayoutData *l = (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-            size = l ? (Vector2){l->measuredWidth, l->measuredHeight} : (Vector2){0, 0};
+            return false;
         }
-        else
+        for (uint32_t i = 0; i < rows; i++)
         {
-            Rectangle bounds = ZuiGetTransformBounds(itemId);
-            size = (Vector2){bounds.width, bounds.height};
+            const ZuiGridTrack track = ZuiGetGridTrack(grid->rows, grid->rowCount, i);
+            rowsOut[i] = track.mode == ZUI_SIZE_FIXED ? track.size : 0.0F;
         }
 
-        if (a)
+        for (uint32_t i = 0; i < index; i++)
         {
-            if (a->widthMode == ZUI_SIZE_FIXED)
+            const ZuiMeasureEntry *e = &entries[i];
+            const uint32_t span = e->columnSpan < columnCount ? e->columnSpan : columnCount;
+            if (span > 1)
             {
-                size.x = a->fixedWidth;
+                ZuiSpreadGridSpan(grid->columns, grid->columnCount, columns, e->column, span,
+                                  e->size.x + (e->margin * 2.0F), layout->spacing);
             }
-            if (a->heightMode == ZUI_SIZE_FIXED)
+            if (e->rowSpan == 1 && ZuiGetGridTrack(grid->rows, grid->rowCount, e->row).mode != ZUI_SIZE_FIXED)
             {
-                size.y = a->fixedHeight;
+                rowsOut[e->row] = fmaxf(rowsOut[e->row], e->size.y + (e->margin * 2.0F));
             }
         }
-        return size;
+        for (uint32_t i = 0; rowSpans && i < index; i++)
+        {
+            const ZuiMeasureEntry *e = &entries[i];
+            if (e->rowSpan > 1)
+            {
+                ZuiSpreadGridSpan(grid->rows, grid->rowCount, rowsOut, e->row, e->rowSpan,
+                                  e->size.y + (e->margin * 2.0F), layout->spacing);
+            }
+        }
+
+        *columnSizes = columns;
+        *rowSizes = rowsOut;
+        *rowCount = rows;
+        return true;
     }
 
-    // NOLINTBEGIN(misc-no-recursion)
-    void ZuiMeasureRecursive(uint32_t itemId, int depth)
+    static void ZuiMeasureGrid(const ZuiItem *item, ZuiLayoutData *layout, ZuiMeasureEntry *entries)
     {
-        if (depth >= ZUI_MAX_TREE_DEPTH)
+        // Outside a layout pass the records are scratch, like the track sizes
+        const ZuiArenaMarker marker = ZuiArenaMark(&g_zui_ctx->frameArena);
+        ZuiMeasureEntry *records = entries ? entries : ZUI_FRAME_ALLOC_ARRAY(ZuiMeasureEntry, item->childCount);
+        float *columns = NULL;
+        float *rows = NULL;
+        uint32_t rowCount = 0;
+        float width = 0.0F;
+        float height = 0.0F;
+        const ZuiGridData *grid = ZuiGetGridData(item->id);
+        if (records && ZuiSolveGrid(item, layout, grid, records, true, &columns, &rows, &rowCount))
         {
-            return;
+            width = ZuiResolveGridTracks(grid->columns, grid->columnCount, columns, ZuiGetGridColumnCount(grid),
+                                         layout->spacing, -1.0F);
+            height = ZuiResolveGridTracks(grid->rows, grid->rowCount, rows, rowCount, layout->spacing, -1.0F);
         }
+        ZuiArenaRestore(&g_zui_ctx->frameArena, marker);
 
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item || !item->isContainer)
+        layout->measuredWidth = width + (layout->padding * 2.0F);
+        layout->measuredHeight = height + (layout->padding * 2.0F);
+    }
+
+    // One level only, children must already carry their measured sizes
+    static void ZuiMeasureLayout(const ZuiItem *item, ZuiLayoutData *layout)
+    {
+        layout->measurePass = 0;
+        uint32_t childCount = item->childCount;
+        if (childCount == 0)
         {
+            layout->measuredWidth = layout->padding * 2.0F;
+            layout->measuredHeight = layout->padding * 2.0F;
             return;
         }
 
-        ZuiLayoutData *layout = (ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-        if (!layout || layout->kind == ZUI_LAYOUT_NONE)
+        // Arrange reads the records back through their offset, the pass restores the arena before it reuses it
+        ZuiMeasureEntry *entries =
+            g_zui_ctx->layoutPass != 0 ? ZUI_FRAME_ALLOC_ARRAY(ZuiMeasureEntry, childCount) : NULL;
+        if (entries)
         {
-            return;
+            layout->measurePass = g_zui_ctx->layoutPass;
+            layout->measureOffset = (size_t)((unsigned char *)entries - g_zui_ctx->frameArena.buffer);
         }
 
-        const uint32_t *childIds = (uint32_t *)item->children.items;
-        for (uint32_t i = 0; i < item->children.count; i++)
+        if (layout->kind == ZUI_LAYOUT_WRAP)
         {
-            ZuiMeasureRecursive(childIds[i], depth + 1);
+            ZuiMeasureWrap(item, layout, entries);
+            return;
         }
-
-        uint32_t childCount = item->children.count;
-        if (childCount == 0)
+        if (layout->kind == ZUI_LAYOUT_GRID)
         {
-            layout->measuredWidth = layout->padding * 2.0F;
-            layout->measuredHeight = layout->padding * 2.0F;
+            ZuiMeasureGrid(item, layout, entries);
             return;
         }
 
@@ -2326,21 +4905,22 @@ extern "C"
         float primary = 0.0F;
         float secondary = 0.0F;
 
-        for (uint32_t i = 0; i < childCount; i++)
+        uint32_t index = 0;
+        for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
         {
-            Vector2 childSize = ZuiMeasureWidget(childIds[i]);
-            const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(childIds[i], ZUI_COMPONENT_ALIGN);
-            float margin = a ? a->margin : 0.0F;
+            ZuiMeasureEntry local;
+            const ZuiMeasureEntry *e = ZuiMeasureChild(childId, entries ? &entries[index++] : &local);
+            float margin = e->margin * 2.0F;
 
             if (isVertical)
             {
-                primary += childSize.y + (margin * 2.0F);
-                secondary = fmaxf(secondary, childSize.x + (margin * 2.0F));
+                primary += e->size.y + margin;
+                secondary = fmaxf(secondary, e->size.x + margin);
             }
             else
             {
-                primary += childSize.x + (margin * 2.0F);
-                secondary = fmaxf(secondary, childSize.y + (margin * 2.0F));
+                primary += e->size.x + margin;
+                secondary = fmaxf(secondary, e->size.y + margin);
             }
         }
 
@@ -2360,9 +4940,30 @@ extern "C"
             layout->measuredHeight = secondary + (layout->padding * 2.0F);
         }
     }
-    // NOLINTEND(misc-no-recursion)
 
-    // NOLINTBEGIN(misc-no-recursion)
+    // Post-order, every layout is measured after the layouts below it
+    void ZuiMeasureTree(uint32_t itemId)
+    {
+        ZUI_ASSERT_CTX_RETURN();
+        const uint32_t base = ZuiBeginWalk(itemId, (Rectangle){0});
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            const ZuiItem *item = ZuiGetItem(entry.id);
+            ZuiLayoutData *layout = item && item->isContainer ? ZuiGetActiveLayout(entry.id) : NULL;
+            if (!layout)
+            {
+                continue;
+            }
+            if (!entry.expanded)
+            {
+                ZuiExpandWalk(entry, (Rectangle){0});
+                continue;
+            }
+            ZuiMeasureLayout(item, layout);
+        }
+    }
+
     static float ZuiAlignValue(float childSize, float parentSize, ZuiAlign align)
     {
         if (align == ZUI_ALIGN_CENTER)
@@ -2376,21 +4977,139 @@ extern "C"
         return 0.0F;
     }
 
-    void ZuiArrangeRecursive(uint32_t itemId, Rectangle bounds, int depth)
+    // Children are parent-relative, a moved child only needs its own subtree redone if its size changed
+    static void ZuiPlaceLayoutChild(uint32_t childId, Rectangle childBounds)
     {
-        if (depth >= ZUI_MAX_TREE_DEPTH)
+        const Rectangle previous = ZuiGetLayoutBounds(childId);
+        ZuiSetTransformBounds(childId, childBounds);
+        const ZuiLayoutData *childLayout = ZuiGetActiveLayout(childId);
+        if (childLayout && (!childLayout->isFinalized || childLayout->needsArrange ||
+                            previous.width != childBounds.width || previous.height != childBounds.height))
         {
-            return;
+            ZuiPushWalk(childId, ZUI_ID_INVALID, childBounds);
         }
+    }
 
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item || !item->isContainer)
+    // Lines are found and placed in one pass, each line is scanned once for its height and once to place it
+    static void ZuiArrangeWrap(const ZuiItem *item, ZuiLayoutData *layout, Rectangle bounds, Rectangle content,
+                               const ZuiMeasureEntry *entries)
+    {
+        const float spacing = layout->spacing;
+        float y = content.y;
+        uint32_t index = 0;
+        uint32_t childId = item->firstChild;
+        while (childId != ZUI_ID_INVALID)
         {
-            return;
+            float lineWidth = 0.0F;
+            float lineHeight = 0.0F;
+            uint32_t lineCount = 0;
+            for (uint32_t nextId = childId; nextId != ZUI_ID_INVALID; nextId = ZuiItemNextSibling(nextId))
+            {
+                ZuiMeasureEntry local;
+                const ZuiMeasureEntry *e = entries ? &entries[index + lineCount] : ZuiMeasureChild(nextId, &local);
+                const float childWidth = e->size.x + (e->margin * 2.0F);
+                if (ZuiWrapBreaks(lineCount, lineWidth, childWidth, spacing, content.width))
+                {
+                    break;
+                }
+                lineWidth += (lineCount > 0 ? spacing : 0.0F) + childWidth;
+                lineHeight = fmaxf(lineHeight, e->size.y + (e->margin * 2.0F));
+                lineCount++;
+            }
+
+            float x = content.x;
+            for (uint32_t i = 0; i < lineCount && childId != ZUI_ID_INVALID; i++)
+            {
+                ZuiMeasureEntry local;
+                const ZuiMeasureEntry *e = entries ? &entries[index + i] : ZuiMeasureChild(childId, &local);
+                const ZuiAlign align = e->align != ZUI_ALIGN_START ? e->align : layout->childAlign;
+                const float offsetY = ZuiAlignValue(e->size.y + (e->margin * 2.0F), lineHeight, align);
+                const uint32_t nextId = ZuiItemNextSibling(childId);
+                ZuiPlaceLayoutChild(childId, (Rectangle){x + e->margin, y + offsetY + e->margin, e->size.x, e->size.y});
+                x += e->size.x + (e->margin * 2.0F) + spacing;
+                childId = nextId;
+            }
+            index += lineCount;
+            y += lineHeight + spacing;
         }
 
-        ZuiLayoutData *layout = (ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-        if (!layout || layout->kind == ZUI_LAYOUT_NONE)
+        layout->isFinalized = true;
+        layout->needsArrange = false;
+
+        // The height depends on the width handed out, so an auto height that no longer fits gets re-measured upwards
+        const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(item->id, ZUI_COMPONENT_ALIGN);
+        const bool autoHeight = item->parentId != ZUI_ID_INVALID && ZuiGetActiveLayout(item->parentId)
+                                    ? !a || a->heightMode == ZUI_SIZE_AUTO
+                                    : layout->hugHeight;
+        const float wrappedHeight = fmaxf(0.0F, y - spacing - content.y) + (layout->padding * 2.0F);
+        if (autoHeight && wrappedHeight != bounds.height)
+        {
+            ZuiInvalidateLayout(item->id);
+        }
+    }
+
+    // A cell runs from the start of its first track to the end of its last, children align inside it on both axes
+    static void ZuiArrangeGrid(const ZuiItem *item, ZuiLayoutData *layout, Rectangle content, ZuiMeasureEntry *entries)
+    {
+        const ZuiArenaMarker marker = ZuiArenaMark(&g_zui_ctx->frameArena);
+        ZuiMeasureEntry *records = entries ? entries : ZUI_FRAME_ALLOC_ARRAY(ZuiMeasureEntry, item->childCount);
+        const ZuiGridData *grid = ZuiGetGridData(item->id);
+        const uint32_t columnCount = ZuiGetGridColumnCount(grid);
+        float *columns = NULL;
+        float *rows = NULL;
+        uint32_t rowCount = 0;
+        if (records && ZuiSolveGrid(item, layout, grid, records, entries == NULL, &columns, &rows, &rowCount))
+        {
+            ZuiResolveGridTracks(grid->columns, grid->columnCount, columns, columnCount, layout->spacing,
+                                 content.width);
+            ZuiResolveGridTracks(grid->rows, grid->rowCount, rows, rowCount, layout->spacing, content.height);
+
+            float *columnStart = ZUI_FRAME_ALLOC_ARRAY(float, columnCount);
+            float *rowStart = ZUI_FRAME_ALLOC_ARRAY(float, rowCount);
+            if (columnStart && rowStart)
+            {
+                for (uint32_t i = 0; i < columnCount; i++)
+                {
+                    columnStart[i] = i > 0 ? columnStart[i - 1] + columns[i - 1] + layout->spacing : content.x;
+                }
+                for (uint32_t i = 0; i < rowCount; i++)
+                {
+                    rowStart[i] = i > 0 ? rowStart[i - 1] + rows[i - 1] + layout->spacing : content.y;
+                }
+
+                uint32_t index = 0;
+                for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID;
+                     childId = ZuiItemNextSibling(childId))
+                {
+                    const ZuiMeasureEntry *e = &records[index++];
+                    const uint32_t span = e->columnSpan < columnCount ? e->columnSpan : columnCount;
+                    const uint32_t lastColumn = e->column + span - 1;
+                    const uint32_t lastRow = e->row + e->rowSpan - 1;
+                    const float cellWidth = columnStart[lastColumn] + columns[lastColumn] - columnStart[e->column];
+                    const float cellHeight = rowStart[lastRow] + rows[lastRow] - rowStart[e->row];
+                    const float innerWidth = fmaxf(0.0F, cellWidth - (e->margin * 2.0F));
+                    const float innerHeight = fmaxf(0.0F, cellHeight - (e->margin * 2.0F));
+                    const float width = e->fillWidth ? innerWidth : e->size.x;
+                    const float height = e->fillHeight ? innerHeight : e->size.y;
+                    const ZuiAlign align = e->align != ZUI_ALIGN_START ? e->align : layout->childAlign;
+                    const float x = columnStart[e->column] + e->margin + ZuiAlignValue(width, innerWidth, align);
+                    const float y = rowStart[e->row] + e->margin + ZuiAlignValue(height, innerHeight, align);
+                    ZuiPlaceLayoutChild(childId, (Rectangle){x, y, width, height});
+                }
+            }
+        }
+        ZuiArenaRestore(&g_zui_ctx->frameArena, marker);
+
+        layout->isFinalized = true;
+        layout->needsArrange = false;
+    }
+
+    // Places one level, child layouts that need their own pass are pushed onto the running walk
+    static void ZuiArrangeLayout(uint32_t itemId, Rectangle bounds)
+    {
+        const ZuiItem *item = ZuiGetItem(itemId);
+        ZuiLayoutData *layout = item && item->isContainer ? ZuiGetActiveLayout(itemId) : NULL;
+        if (!layout)
         {
             return;
         }
@@ -2403,36 +5122,49 @@ extern "C"
             bounds.width - (layout->padding * 2.0F),
             bounds.height - (layout->padding * 2.0F)};
 
-        uint32_t childCount = item->children.count;
+        uint32_t childCount = item->childCount;
         if (childCount == 0)
         {
             layout->isFinalized = true;
+            layout->needsArrange = false;
+            return;
+        }
+
+        ZuiMeasureEntry *entries = ZuiGetMeasureEntries(layout);
+        if (!entries)
+        {
+            ZuiMeasureLayout(item, layout);
+            entries = ZuiGetMeasureEntries(layout);
+        }
+
+        if (layout->kind == ZUI_LAYOUT_WRAP)
+        {
+            ZuiArrangeWrap(item, layout, bounds, content, entries);
+            return;
+        }
+        if (layout->kind == ZUI_LAYOUT_GRID)
+        {
+            ZuiArrangeGrid(item, layout, content, entries);
             return;
         }
 
-        const uint32_t *childIds = (uint32_t *)item->children.items;
         bool isVertical = (layout->kind == ZUI_LAYOUT_VERTICAL);
 
         uint32_t fillCount = 0;
         float fixedTotal = 0.0F;
 
-        for (uint32_t i = 0; i < childCount; i++)
+        uint32_t index = 0;
+        for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
         {
-            Vector2 childSize = ZuiMeasureWidget(childIds[i]);
-            const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(childIds[i], ZUI_COMPONENT_ALIGN);
-            float margin = a ? a->margin : 0.0F;
-
-            bool fillsPrimary = a && ((isVertical && a->heightMode == ZUI_SIZE_FILL) ||
-                                      (!isVertical && a->widthMode == ZUI_SIZE_FILL));
-
-            if (fillsPrimary)
+            ZuiMeasureEntry local;
+            const ZuiMeasureEntry *e = entries ? &entries[index++] : ZuiMeasureChild(childId, &local);
+            if (isVertical ? e->fillHeight : e->fillWidth)
             {
                 fillCount++;
             }
             else
             {
-                float size = isVertical ? childSize.y : childSize.x;
-                fixedTotal += size + (margin * 2.0F);
+                fixedTotal += (isVertical ? e->size.y : e->size.x) + (e->margin * 2.0F);
             }
         }
 
@@ -2442,25 +5174,21 @@ extern "C"
 
         float cursor = isVertical ? content.y : content.x;
 
-        for (uint32_t i = 0; i < childCount; i++)
+        index = 0;
+        for (uint32_t childId = item->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
         {
-            Vector2 childSize = ZuiMeasureWidget(childIds[i]);
-            const ZuiAlignData *a = (const ZuiAlignData *)ZuiItemGetComponent(childIds[i], ZUI_COMPONENT_ALIGN);
-            float margin = a ? a->margin : 0.0F;
-            ZuiAlign align = a && a->align != ZUI_ALIGN_START ? a->align : layout->childAlign;
+            ZuiMeasureEntry local;
+            const ZuiMeasureEntry *e = entries ? &entries[index++] : ZuiMeasureChild(childId, &local);
+            float margin = e->margin;
+            ZuiAlign align = e->align != ZUI_ALIGN_START ? e->align : layout->childAlign;
 
             cursor += margin;
 
-            bool primaryFills =
-                a && ((isVertical && a->heightMode == ZUI_SIZE_FILL) ||
-                      (!isVertical && a->widthMode == ZUI_SIZE_FILL));
-
-            bool secondaryFills =
-                a && ((isVertical && a->widthMode == ZUI_SIZE_FILL) ||
-                      (!isVertical && a->heightMode == ZUI_SIZE_FILL));
+            bool primaryFills = isVertical ? e->fillHeight : e->fillWidth;
+            bool secondaryFills = isVertical ? e->fillWidth : e->fillHeight;
 
-            float primaryMeasured = isVertical ? childSize.y : childSize.x;
-            float secondaryMeasured = isVertical ? childSize.x : childSize.y;
+            float primaryMeasured = isVertical ? e->size.y : e->size.x;
+            float secondaryMeasured = isVertical ? e->size.x : e->size.y;
 
             float primaryLimit = fillSize;
             float secondaryLimit = isVertical ? content.width : content.height;
@@ -2480,15 +5208,26 @@ extern "C"
                 childBounds = (Rectangle){cursor, content.y + offsetY, primarySize, secondarySize};
             }
 
-            ZuiSetTransformBounds(childIds[i], childBounds);
-            ZuiArrangeRecursive(childIds[i], childBounds, depth + 1);
+            ZuiPlaceLayoutChild(childId, childBounds);
             cursor += primarySize + margin + layout->spacing;
         }
 
         layout->isFinalized = true;
+        layout->needsArrange = false;
+    }
+
+    // Pre-order, a layout is placed by its parent before it places its own children
+    void ZuiArrangeTree(uint32_t itemId, Rectangle bounds)
+    {
+        ZUI_ASSERT_CTX_RETURN();
+        const uint32_t base = ZuiBeginWalk(itemId, bounds);
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            ZuiArrangeLayout(entry.id, entry.rect);
+        }
     }
 
-    // NOLINTEND(misc-no-recursion)
     ZuiResult ZuiItemSetLayout(uint32_t itemId, ZuiLayoutKind kind)
     {
         const ZuiItem *item = ZuiGetItem(itemId);
@@ -2501,6 +5240,7 @@ extern "C"
         if (l)
         {
             l->kind = kind;
+            ZuiInvalidateLayout(itemId);
             return ZUI_OK;
         }
 
@@ -2525,6 +5265,7 @@ extern "C"
         if (l)
         {
             l->spacing = spacing;
+            ZuiInvalidateLayout(itemId);
         }
     }
 
@@ -2534,6 +5275,7 @@ extern "C"
         if (l)
         {
             l->padding = padding;
+            ZuiInvalidateLayout(itemId);
         }
     }
 
@@ -2543,6 +5285,7 @@ extern "C"
         if (l)
         {
             l->childAlign = align;
+            ZuiInvalidateLayout(itemId);
         }
     }
 
@@ -2552,6 +5295,7 @@ extern "C"
         if (a)
         {
             a->align = align;
+            ZuiInvalidateLayout(itemId);
         }
     }
 
@@ -2561,6 +5305,7 @@ extern "C"
         if (a)
         {
             a->align = align;
+            ZuiInvalidateLayout(g_zui_ctx->cursor.activeItem);
         }
     }
 
@@ -2571,6 +5316,7 @@ extern "C"
         {
             a->widthMode = widthMode;
             a->heightMode = heightMode;
+            ZuiInvalidateLayout(itemId);
         }
     }
 
@@ -2585,6 +5331,7 @@ extern "C"
         a->heightMode = ZUI_SIZE_FIXED;
         a->fixedWidth = width;
         a->fixedHeight = height;
+        ZuiInvalidateLayout(itemId);
     }
 
     void ZuiItemSetMargin(uint32_t itemId, float margin)
@@ -2595,6 +5342,76 @@ extern "C"
             return;
         }
         a->margin = margin;
+        ZuiInvalidateLayout(itemId);
+    }
+
+    void ZuiItemSetGridSpan(uint32_t itemId, uint32_t columnSpan, uint32_t rowSpan)
+    {
+        ZuiAlignData *a = ZuiGetOrCreateAlignData(itemId);
+        if (!a)
+        {
+            return;
+        }
+        a->columnSpan = ZuiClampGridSpan(columnSpan);
+        a->rowSpan = ZuiClampGridSpan(rowSpan);
+        ZuiInvalidateLayout(itemId);
+    }
+
+    void ZuiItemSpanLast(uint32_t columnSpan, uint32_t rowSpan)
+    {
+        ZUI_ASSERT_CTX_RETURN();
+        ZuiItemSetGridSpan(g_zui_ctx->cursor.activeItem, columnSpan, rowSpan);
+    }
+
+    static ZuiResult ZuiSetGridTracks(uint32_t itemId, const ZuiGridTrack *tracks, uint32_t count, bool columns)
+    {
+        if (!ZuiItemHasComponent(itemId, ZUI_COMPONENT_LAYOUT))
+        {
+            return ZUI_ERROR_INVALID_ID;
+        }
+        if (count > 0 && !tracks)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_NULL_POINTER, "Grid tracks are NULL");
+            return ZUI_ERROR_NULL_POINTER;
+        }
+        if (count > ZUI_GRID_MAX_TRACKS)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Grid has %u tracks, at most %u are supported", count,
+                             ZUI_GRID_MAX_TRACKS);
+            return ZUI_ERROR_INVALID_VALUE;
+        }
+
+        ZuiGridData *grid = (ZuiGridData *)ZuiEnsureComponent(itemId, ZUI_COMPONENT_GRID);
+        if (!grid)
+        {
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+        grid->itemId = itemId;
+        ZuiGridTrack *target = columns ? grid->columns : grid->rows;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            target[i] = tracks[i];
+        }
+        if (columns)
+        {
+            grid->columnCount = count;
+        }
+        else
+        {
+            grid->rowCount = count;
+        }
+        ZuiInvalidateLayout(itemId);
+        return ZUI_OK;
+    }
+
+    ZuiResult ZuiGridSetColumns(uint32_t itemId, const ZuiGridTrack *tracks, uint32_t count)
+    {
+        return ZuiSetGridTracks(itemId, tracks, count, true);
+    }
+
+    ZuiResult ZuiGridSetRows(uint32_t itemId, const ZuiGridTrack *tracks, uint32_t count)
+    {
+        return ZuiSetGridTracks(itemId, tracks, count, false);
     }
 
     uint32_t ZuiBeginVertical(Vector2 pos, float spacing, Color color)
@@ -2615,66 +5432,78 @@ extern "C"
         return id;
     }
 
-    // NOLINTBEGIN(misc-no-recursion)
+    // Post-order, a finished container folds its extent into its parent's entry, rect holds min x/y and max x/y
     Vector2 ZuiCalculateContentSize(uint32_t itemId)
     {
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item || !item->isContainer)
+        const ZuiItem *root = ZuiGetItem(itemId);
+        if (!root || !root->isContainer)
         {
             return (Vector2){0, 0};
         }
 
-        if (item->children.count == 0)
+        const Rectangle empty = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+        Vector2 size = {0, 0};
+        const uint32_t base = ZuiBeginWalk(itemId, (Rectangle){0});
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
         {
-            const ZuiLayoutData *layout = (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-            if (layout)
+            const ZuiItem *item = ZuiGetItem(entry.id);
+            if (!item)
             {
-                return (Vector2){layout->measuredWidth, layout->measuredHeight};
+                continue;
+            }
+            if (!entry.expanded && item->isContainer && item->childCount > 0)
+            {
+                ZuiExpandWalk(entry, empty);
+                continue;
+            }
+
+            Vector2 content = {0, 0};
+            if (item->isContainer)
+            {
+                const ZuiLayoutData *layout = (const ZuiLayoutData *)ZuiItemGetComponent(entry.id, ZUI_COMPONENT_LAYOUT);
+                if (item->childCount == 0)
+                {
+                    content = layout ? (Vector2){layout->measuredWidth, layout->measuredHeight} : (Vector2){0, 0};
+                }
+                else
+                {
+                    float padding = layout ? layout->padding : 0.0F;
+                    content.x = fmaxf(0.0F, entry.rect.width - entry.rect.x + (padding * 2.0F));
+                    content.y = fmaxf(0.0F, entry.rect.height - entry.rect.y + (padding * 2.0F));
+                }
             }
-            return (Vector2){0, 0};
-        }
 
-        float minX = FLT_MAX;
-        float minY = minX;
-        float maxX = -FLT_MAX;
-        float maxY = maxX;
+            if (entry.parent == ZUI_ID_INVALID)
+            {
+                size = content;
+                continue;
+            }
 
-        for (uint32_t i = 0; i < item->children.count; i++)
-        {
-            uint32_t childId = *(uint32_t *)ZuiGetDynArray(&item->children, i);
-            Rectangle childBounds = ZuiGetTransformBounds(childId);
-            const ZuiTransformData *transform = (const ZuiTransformData *)ZuiItemGetComponent(childId, ZUI_COMPONENT_TRANSFORM);
+            Rectangle childBounds = ZuiGetTransformBounds(entry.id);
+            const ZuiTransformData *transform = (const ZuiTransformData *)ZuiItemGetComponent(entry.id, ZUI_COMPONENT_TRANSFORM);
             if (transform)
             {
                 childBounds.x += transform->offset.x;
                 childBounds.y += transform->offset.y;
             }
 
-            minX = fminf(minX, childBounds.x);
-            minY = fminf(minY, childBounds.y);
-            maxX = fmaxf(maxX, childBounds.x + childBounds.width);
-            maxY = fmaxf(maxY, childBounds.y + childBounds.height);
-
-            const ZuiItem *childItem = ZuiGetItem(childId);
-            if (childItem && childItem->isContainer)
+            float maxX = childBounds.x + childBounds.width;
+            float maxY = childBounds.y + childBounds.height;
+            if (item->isContainer)
             {
-                Vector2 childContent = ZuiCalculateContentSize(childId);
-                float childMaxX = childBounds.x + childContent.x;
-                float childMaxY = childBounds.y + childContent.y;
-                maxX = fmaxf(maxX, childMaxX);
-                maxY = fmaxf(maxY, childMaxY);
+                maxX = fmaxf(maxX, childBounds.x + content.x);
+                maxY = fmaxf(maxY, childBounds.y + content.y);
             }
-        }
-
-        const ZuiLayoutData *layout = (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-        float padding = layout ? layout->padding : 0.0F;
-
-        float width = fmaxf(0.0F, maxX - minX + (padding * 2.0F));
-        float height = fmaxf(0.0F, maxY - minY + (padding * 2.0F));
 
-        return (Vector2){width, height};
+            Rectangle *extent = &ZuiWalkAt(entry.parent)->rect;
+            extent->x = fminf(extent->x, childBounds.x);
+            extent->y = fminf(extent->y, childBounds.y);
+            extent->width = fmaxf(extent->width, maxX);
+            extent->height = fmaxf(extent->height, maxY);
+        }
+        return size;
     }
-    // NOLINTEND(misc-no-recursion)
 
     void ZuiEndLayout(void)
     {
@@ -2688,25 +5517,30 @@ extern "C"
             return;
         }
 
-        ZuiMeasureRecursive(itemId, 0);
-        layout = (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
-        if (!layout)
+        ZuiBeginLayoutPass();
+        ZuiMeasureTree(itemId);
+        ZuiLayoutData *measured = (ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
+        if (!measured)
         {
+            ZuiEndLayoutPass();
             g_zui_ctx->cursor.activeFrame = g_zui_ctx->cursor.parentFrame;
             return;
         }
 
-        Rectangle bounds = ZuiGetTransformBounds(itemId);
-        if (bounds.width == 0)
+        Rectangle bounds = ZuiGetLayoutBounds(itemId);
+        measured->hugWidth = bounds.width == 0;
+        measured->hugHeight = bounds.height == 0;
+        if (measured->hugWidth)
         {
-            bounds.width = layout->measuredWidth;
+            bounds.width = measured->measuredWidth;
         }
-        if (bounds.height == 0)
+        if (measured->hugHeight)
         {
-            bounds.height = layout->measuredHeight;
+            bounds.height = measured->measuredHeight;
         }
 
-        ZuiArrangeRecursive(itemId, bounds, 0);
+        ZuiArrangeTree(itemId, bounds);
+        ZuiEndLayoutPass();
 
         ZuiScrollData *scroll = (ZuiScrollData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_SCROLL);
         if (scroll)
@@ -2724,25 +5558,174 @@ extern "C"
         g_zui_ctx->cursor.activeFrame = g_zui_ctx->cursor.parentFrame;
     }
 
-    uint32_t ZuiBeginRow(float spacing)
+    // Layouts that were never arranged are still being built, ZuiEndLayout measures them in one go
+    void ZuiInvalidateLayout(uint32_t itemId)
+    {
+        if (!g_zui_ctx || !ZuiIsItemAlive(itemId))
+        {
+            return;
+        }
+
+        // A pending flag on the item's own layout, or on the parent for leaves, means a queued walk already covers it
+        const ZuiItem *item = ZuiGetItem(itemId);
+        ZuiLayoutData *layout = ZuiGetActiveLayout(itemId);
+        if ((!layout || !layout->isFinalized) && item->parentId != ZUI_ID_INVALID)
+        {
+            layout = ZuiGetActiveLayout(item->parentId);
+        }
+        if (!layout || !layout->isFinalized || layout->needsArrange)
+        {
+            return;
+        }
+
+        ZuiDynArray *queue = &g_zui_ctx->layoutQueue;
+        if (!queue->items && ZuiInitDynArray(queue, &g_zui_arena, ZUI_ITEMS_CAPACITY, sizeof(uint32_t),
+                                             ZUI_ALIGNOF(uint32_t), "LayoutQueue") != ZUI_OK)
+        {
+            return;
+        }
+        uint32_t *slot = (uint32_t *)ZuiPushDynArray(queue, &g_zui_arena);
+        if (slot)
+        {
+            *slot = itemId;
+            layout->needsArrange = true;
+        }
+    }
+
+    // Re-measures upwards until a layout keeps its size, then re-arranges below that layout only
+    static void ZuiRelayout(uint32_t itemId)
+    {
+        if (!ZuiIsItemAlive(itemId))
+        {
+            return;
+        }
+
+        ZuiLayoutData *own = ZuiGetActiveLayout(itemId);
+        if (own)
+        {
+            ZuiMeasureLayout(ZuiGetItem(itemId), own);
+            own->needsArrange = true;
+        }
+
+        uint32_t childId = itemId;
+        for (;;)
+        {
+            const ZuiItem *child = ZuiGetItem(childId);
+            ZuiLayoutData *parent =
+                child && child->parentId != ZUI_ID_INVALID ? ZuiGetActiveLayout(child->parentId) : NULL;
+            if (!parent || !parent->isFinalized)
+            {
+                ZuiLayoutData *top = ZuiGetActiveLayout(childId);
+                if (top)
+                {
+                    Rectangle bounds = ZuiGetLayoutBounds(childId);
+                    bounds.width = top->hugWidth ? top->measuredWidth : bounds.width;
+                    bounds.height = top->hugHeight ? top->measuredHeight : bounds.height;
+                    ZuiArrangeTree(childId, bounds);
+                }
+                return;
+            }
+
+            const float oldWidth = parent->measuredWidth;
+            const float oldHeight = parent->measuredHeight;
+            ZuiMeasureLayout(ZuiGetItem(child->parentId), parent);
+            parent->needsArrange = true;
+            if (parent->measuredWidth == oldWidth && parent->measuredHeight == oldHeight)
+            {
+                ZuiArrangeTree(child->parentId, ZuiGetLayoutBounds(child->parentId));
+                return;
+            }
+            childId = child->parentId;
+        }
+    }
+
+    void ZuiUpdateLayout(void)
+    {
+        ZUI_ASSERT_CTX_RETURN();
+        // Wraps whose height followed a new width queue themselves while draining, a second round settles them
+        // and anything queued after that waits for the next update instead of looping here
+        ZuiDynArray *queue = &g_zui_ctx->layoutQueue;
+        for (uint32_t round = 0; round < 2 && queue->count > 0; round++)
+        {
+            const uint32_t count = queue->count;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                ZuiBeginLayoutPass();
+                ZuiRelayout(((const uint32_t *)queue->items)[i]);
+                ZuiEndLayoutPass();
+            }
+
+            uint32_t *ids = (uint32_t *)queue->items;
+            for (uint32_t i = count; i < queue->count; i++)
+            {
+                ids[i - count] = ids[i];
+            }
+            queue->count -= count;
+        }
+    }
+
+    uint32_t ZuiBeginRow(float spacing)
+    {
+        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
+        Rectangle b = {g_zui_ctx->cursor.position.x, g_zui_ctx->cursor.position.y, 0, 0};
+        uint32_t id = ZuiBeginFrame(b, BLANK);
+        ZuiItemSetLayout(id, ZUI_LAYOUT_HORIZONTAL);
+        ZuiLayoutSetSpacing(id, spacing);
+        ZuiLayoutSetPadding(id, 0);
+        return id;
+    }
+
+    uint32_t ZuiBeginColumn(float spacing)
+    {
+        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
+        Rectangle b = {g_zui_ctx->cursor.position.x, g_zui_ctx->cursor.position.y, 0, 0};
+        uint32_t id = ZuiBeginFrame(b, BLANK);
+        ZuiItemSetLayout(id, ZUI_LAYOUT_VERTICAL);
+        ZuiLayoutSetSpacing(id, spacing);
+        ZuiLayoutSetPadding(id, 0);
+        return id;
+    }
+
+    // A zero width hugs the content on one line, otherwise the width is fixed so it also holds inside layouts
+    uint32_t ZuiBeginWrap(float width, float spacing)
     {
         ZUI_ASSERT_CTX_RETURN_ID_INVALID();
-        Rectangle b = {g_zui_ctx->cursor.position.x, g_zui_ctx->cursor.position.y, 0, 0};
+        Rectangle b = {g_zui_ctx->cursor.position.x, g_zui_ctx->cursor.position.y, width, 0};
         uint32_t id = ZuiBeginFrame(b, BLANK);
-        ZuiItemSetLayout(id, ZUI_LAYOUT_HORIZONTAL);
+        ZuiItemSetLayout(id, ZUI_LAYOUT_WRAP);
         ZuiLayoutSetSpacing(id, spacing);
         ZuiLayoutSetPadding(id, 0);
+        ZuiAlignData *a = width > 0.0F ? ZuiGetOrCreateAlignData(id) : NULL;
+        if (a)
+        {
+            a->widthMode = ZUI_SIZE_FIXED;
+            a->fixedWidth = width;
+        }
         return id;
     }
 
-    uint32_t ZuiBeginColumn(float spacing)
+    // Equal fill columns, so a zero sized grid hugs its widest cell and repeats it across the row
+    uint32_t ZuiBeginGrid(uint32_t columns, float spacing)
     {
         ZUI_ASSERT_CTX_RETURN_ID_INVALID();
         Rectangle b = {g_zui_ctx->cursor.position.x, g_zui_ctx->cursor.position.y, 0, 0};
         uint32_t id = ZuiBeginFrame(b, BLANK);
-        ZuiItemSetLayout(id, ZUI_LAYOUT_VERTICAL);
+        ZuiItemSetLayout(id, ZUI_LAYOUT_GRID);
         ZuiLayoutSetSpacing(id, spacing);
         ZuiLayoutSetPadding(id, 0);
+
+        if (columns > ZUI_GRID_MAX_TRACKS)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Grid has %u columns, at most %u are supported", columns,
+                             ZUI_GRID_MAX_TRACKS);
+        }
+        ZuiGridTrack tracks[ZUI_GRID_MAX_TRACKS];
+        const uint32_t count = columns < ZUI_GRID_MAX_TRACKS ? columns : ZUI_GRID_MAX_TRACKS;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            tracks[i] = (ZuiGridTrack){ZUI_SIZE_FILL, 1.0F};
+        }
+        ZuiGridSetColumns(id, tracks, count);
         return id;
     }
 
@@ -2775,6 +5758,8 @@ extern "C"
     void ZuiEndHorizontal(void) { ZuiEndLayout(); }
     void ZuiEndRow(void) { ZuiEndLayout(); }
     void ZuiEndColumn(void) { ZuiEndLayout(); }
+    void ZuiEndWrap(void) { ZuiEndLayout(); }
+    void ZuiEndGrid(void) { ZuiEndLayout(); }
     void ZuiEndFrameAuto(void) { ZuiEndLayout(); }
 
     //-------------------------------------------------------- ANIMATION
@@ -2786,6 +5771,10 @@ extern "C"
             return NULL;
         }
         ZuiAnimationData *a = (ZuiAnimationData *)ZuiEnsureComponent(itemId, ZUI_COMPONENT_ANIMATION);
+        if (a && slot >= ZUI_ANIM_SLOT_OFFSET_X && slot <= ZUI_ANIM_SLOT_SCALE)
+        {
+            ZuiInvalidateWorldBounds(itemId); // callers may write the value through the pointer
+        }
         return a ? &a->slots[slot] : NULL;
     }
 
@@ -2794,6 +5783,14 @@ extern "C"
         ZuiAnimation *anim = ZuiGetAnimSlot(itemId, slot);
         if (anim)
         {
+            if (!anim->active && anim->target == target && anim->value == target)
+            {
+                return; // already settled, waking the slot would keep the item dirty every frame
+            }
+            if (anim->target != target)
+            {
+                ZuiMarkDirty(itemId);
+            }
             anim->target = target;
 
             if (!anim->active)
@@ -2882,6 +5879,7 @@ extern "C"
         if (g_zui_ctx->g_focusContext.currentFocus != UINT_MAX)
         {
             uint32_t oldId = g_zui_ctx->g_focusContext.currentFocus;
+            ZuiMarkDirty(oldId);
 
             ZuiFocusData *oldFocus = (ZuiFocusData *)ZuiItemGetComponent(oldId, ZUI_COMPONENT_FOCUS);
             if (oldFocus)
@@ -2910,6 +5908,7 @@ extern "C"
         }
 
         g_zui_ctx->g_focusContext.currentFocus = itemId;
+        ZuiMarkDirty(itemId);
         if (newFocus->onFocusGained)
         {
             newFocus->onFocusGained(itemId);
@@ -2922,6 +5921,7 @@ extern "C"
         if (f && f->isFocused)
         {
             f->isFocused = false;
+            ZuiMarkDirty(itemId);
             if (f->onFocusLost)
             {
                 f->onFocusLost(itemId);
@@ -3052,30 +6052,18 @@ extern "C"
 
     //--------------------------------------------------------SCROLL
 
-    // NOLINTBEGIN(misc-no-recursion)
-    void ZuiApplyScrollOffsetRecursive(uint32_t itemId, Vector2 offset)
+    // Descendants are placed relative to the item, so they follow without being touched
+    void ZuiApplyScrollOffset(uint32_t itemId, Vector2 offset)
     {
         ZuiTransformData *transform = (ZuiTransformData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_TRANSFORM);
         if (transform)
         {
             transform->offset.x += offset.x;
             transform->offset.y += offset.y;
-        }
-
-        const ZuiItem *item = ZuiGetItem(itemId);
-        if (!item || !item->isContainer)
-        {
-            return;
-        }
-
-        const uint32_t *childIds = (uint32_t *)item->children.items;
-        for (uint32_t i = 0; i < item->children.count; i++)
-        {
-            ZuiApplyScrollOffsetRecursive(childIds[i], offset);
+            ZuiInvalidateTransform(transform);
         }
     }
 
-    // NOLINTEND(misc-no-recursion)
     Rectangle ZuiGetChildContentBounds(uint32_t childId)
     {
         const ZuiItem *child = ZuiGetItem(childId);
@@ -3178,6 +6166,7 @@ extern "C"
             Vector2 contentSize = ZuiCalculateContentSize(frameId);
             scroll->contentSize = contentSize;
             ZuiFrameEnableScissor(frameId, true);
+            ZuiInvalidateWorldBounds(frameId); // a previous offset may still be applied to the children
         }
     }
 
@@ -3247,6 +6236,7 @@ extern "C"
         if (s)
         {
             s->isEnabled = enabled;
+            ZuiMarkDirty(itemId);
         }
     }
 
@@ -3256,6 +6246,7 @@ extern "C"
         if (s)
         {
             s->isVisible = visible;
+            ZuiMarkDirty(itemId);
         }
     }
 
@@ -3291,7 +6282,13 @@ extern "C"
             int maxOrder = l->order;
             for (uint32_t i = 0; i < g_zui_ctx->items.count; i++)
             {
-                const ZuiLayerData *other = (const ZuiLayerData *)ZuiItemGetComponent(i, ZUI_COMPONENT_LAYER);
+                const ZuiItem *item = ZuiItemArrayAt(&g_zui_ctx->items, i);
+                if (!item || !(item->componentMask & (1U << (uint32_t)ZUI_COMPONENT_LAYER)))
+                {
+                    continue;
+                }
+
+                const ZuiLayerData *other = (const ZuiLayerData *)ZuiItemGetComponent(item->id, ZUI_COMPONENT_LAYER);
                 if (other && other->layer == l->layer && other->order > maxOrder)
                 {
                     maxOrder = other->order;
@@ -3333,55 +6330,40 @@ extern "C"
             return;
         }
 
-        int currentIdx = -1;
-        for (uint32_t i = 0; i < parent->children.count; i++)
-        {
-            const uint32_t *childId = (uint32_t *)ZuiGetDynArray(&parent->children, i);
-            if (*childId == itemId)
-            {
-                currentIdx = (int)i;
-                break;
-            }
-        }
-
-        if (currentIdx == -1 || currentIdx == (int)(parent->children.count - 1))
+        if (parent->lastChild == item->id)
         {
             return;
         }
 
-        for (uint32_t i = (uint32_t)currentIdx; i < parent->children.count - 1; i++)
-        {
-            uint32_t *curr = (uint32_t *)ZuiGetDynArray(&parent->children, i);
-            const uint32_t *next = (uint32_t *)ZuiGetDynArray(&parent->children, i + 1);
-            *curr = *next;
-        }
-        uint32_t *last = (uint32_t *)ZuiGetDynArray(&parent->children, parent->children.count - 1);
-        *last = itemId;
+        ZuiUnlinkChild(parent, item);
+        ZuiAppendChild(parent, item);
     }
 
-    // NOLINTBEGIN(misc-no-recursion)
     void ZuiPropagateLayerToChildren(uint32_t parentId)
     {
         const ZuiLayerData *parentLayer = (const ZuiLayerData *)ZuiItemGetComponent(parentId, ZUI_COMPONENT_LAYER);
-        if (!parentLayer)
-        {
-            return;
-        }
-
         const ZuiItem *parent = ZuiGetItem(parentId);
-        if (!parent || !parent->isContainer)
+        if (!parentLayer || !parent || !parent->isContainer)
         {
             return;
         }
 
-        for (uint32_t i = 0; i < parent->children.count; i++)
+        // Every descendant ends up on the parent's layer, so one pre-order pass replaces the per-level hand-off
+        const int layer = parentLayer->layer;
+        const int order = parentLayer->order;
+        const uint32_t base = g_zui_ctx->walkStack.count;
+        ZuiPushWalkChildren(parentId, ZUI_ID_INVALID);
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
         {
-            uint32_t childId = *(uint32_t *)ZuiGetDynArray(&parent->children, i);
-            ZuiSetLayer(childId, parentLayer->layer, parentLayer->order);
-            ZuiPropagateLayerToChildren(childId);
+            ZuiSetLayer(entry.id, layer, order);
+            const ZuiItem *item = ZuiGetItem(entry.id);
+            if (item && item->isContainer)
+            {
+                ZuiPushWalkChildren(entry.id, ZUI_ID_INVALID);
+            }
         }
     }
-    // NOLINTEND(misc-no-recursion)
 
     //--------------------------------------------------------SPATIAL
 
@@ -3454,7 +6436,7 @@ extern "C"
         }
 
         Vector2 result = point;
-        Rectangle bounds = t->bounds;
+        Rectangle bounds = ZuiGetTransformBounds(itemId);
         float centerY = bounds.y + (bounds.height * 0.5F);
 
         switch (s->mode)
@@ -3496,7 +6478,7 @@ extern "C"
         }
 
         Vector2 result = point;
-        Rectangle bounds = t->bounds;
+        Rectangle bounds = ZuiGetTransformBounds(itemId);
         float centerY = bounds.y + (bounds.height * 0.5F);
 
         switch (s->mode)
@@ -3535,13 +6517,6 @@ extern "C"
         }
 
         item->isContainer = true;
-        ZuiResult result = ZuiInitDynArray(&item->children, &g_zui_arena, ZUI_CHILDREN_CAPACITY,
-                                           sizeof(uint32_t), _Alignof(uint32_t), "Children");
-        if (result != ZUI_OK)
-        {
-            ZUI_REPORT_ERROR(result, "Failed to initialize children");
-            return false;
-        }
         return true;
     }
 
@@ -3561,7 +6536,7 @@ extern "C"
                 return false;
             }
             transform->itemId = itemId;
-            transform->bounds = bounds;
+            transform->bounds = ZuiToLocalBounds(itemId, bounds);
         }
 
         if (flags & (uint32_t)ZUI_COMP_STATE)
@@ -3633,6 +6608,34 @@ extern "C"
 
     //-----------------------------------------------------------------TYPES
 
+    ZuiResult ZuiInitTypeRegistry(void)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
+        memset(&g_zui_ctx->typeRegistry, 0, sizeof(ZuiTypeRegistry));
+        ZuiResult result = ZuiInitPagedArray(&g_zui_ctx->typeRegistry.registrations, &g_zui_arena, ZUI_TYPE_COUNT,
+                                             sizeof(ZuiTypeRegistration), ZUI_ALIGNOF(ZuiTypeRegistration),
+                                             "TypeRegistry");
+        if (result != ZUI_OK)
+        {
+            return result;
+        }
+
+        // Reserve every built-in id, registered or not, so custom types always start at ZUI_TYPE_COUNT
+        for (uint32_t i = 0; i < ZUI_TYPE_COUNT; i++)
+        {
+            ZuiTypeRegistration *slot = ZuiPushPagedArray(&g_zui_ctx->typeRegistry.registrations, &g_zui_arena);
+            if (!slot)
+            {
+                return ZUI_ERROR_OUT_OF_MEMORY;
+            }
+            memset(slot, 0, sizeof(*slot));
+        }
+        return ZUI_OK;
+    }
+
     ZuiResult ZuiRegisterType(ZuiItemType typeId, const ZuiTypeRegistration *info)
     {
         if (!g_zui_ctx || !info)
@@ -3640,18 +6643,28 @@ extern "C"
             return ZUI_ERROR_NULL_POINTER;
         }
 
+        ZuiTypeRegistry *reg = &g_zui_ctx->typeRegistry;
         uint32_t idx = (uint32_t)typeId;
-        if (idx >= ZUI_TYPE_COUNT)
+        if (idx >= ZUI_TYPE_COUNT && idx != reg->registrations.count)
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Invalid type ID %d", typeId);
             return ZUI_ERROR_INVALID_VALUE;
         }
 
-        ZuiTypeRegistry *reg = &g_zui_ctx->typeRegistry;
-        ZuiTypeRegistration *slot = &reg->registrations[idx];
+        ZuiTypeRegistration *slot = idx < reg->registrations.count
+                                        ? ZuiTypeRegistrationPageAt(&reg->registrations, idx)
+                                        : ZuiPushPagedArray(&reg->registrations, &g_zui_arena);
+        if (!slot)
+        {
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+        memset(slot, 0, sizeof(*slot));
 
+        const uint32_t capacity = idx < ZUI_TYPE_COUNT && g_zui_ctx->config.typeCapacities[idx] > 0
+                                      ? g_zui_ctx->config.typeCapacities[idx]
+                                      : info->initialCapacity;
         ZuiResult result = ZuiInitRegistryEntry(&slot->dataArray, slot, idx, info->name,
-                                                info->dataSize, info->dataAlignment, info->initialCapacity);
+                                                info->dataSize, info->dataAlignment, capacity);
         if (result != ZUI_OK)
         {
             return result;
@@ -3660,6 +6673,7 @@ extern "C"
         slot->update = info->update;
         slot->render = info->render;
         slot->init = info->init;
+        slot->alwaysUpdate = info->alwaysUpdate;
         reg->registeredCount++;
         return ZUI_OK;
     }
@@ -3672,7 +6686,6 @@ extern "C"
                 .dataSize = sizeof(ZuiFrameData),
                 .dataAlignment = ZUI_ALIGNOF(ZuiFrameData),
                 .initialCapacity = ZUI_FRAMES_CAPACITY,
-                .update = ZuiUpdateFrame,
                 .render = ZuiRenderFrame,
             },
             {
@@ -3741,6 +6754,21 @@ extern "C"
         }
     }
 
+    // Appends a widget type after the built-ins and returns its runtime id, ZUI_ID_INVALID on failure.
+    // update only runs for dirty items, call ZuiMarkDirty on state changes or set alwaysUpdate to poll
+    uint32_t ZuiRegisterCustomType(const ZuiTypeRegistration *info)
+    {
+        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
+        const uint32_t id = g_zui_ctx->typeRegistry.registrations.count;
+        const ZuiResult result = ZuiRegisterType((ZuiItemType)id, info);
+        if (result != ZUI_OK)
+        {
+            ZUI_REPORT_ERROR(result, "Failed to register type '%s'", info && info->name ? info->name : "?");
+            return ZUI_ID_INVALID;
+        }
+        return id;
+    }
+
     uint32_t ZuiCreateTypedItem(uint32_t typeId)
     {
         ZUI_ASSERT_CTX_RETURN_ID_INVALID();
@@ -3750,30 +6778,24 @@ extern "C"
             return ZUI_ID_INVALID;
         }
 
-        void *data = ZuiAllocRegistryData(&reg->dataArray, reg);
+        uint32_t dataIndex = 0;
+        void *data = ZuiAllocSlotData(&reg->dataArray, &reg->freeSlots, &dataIndex);
         if (!data)
         {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate data for '%s'", reg->name);
             return ZUI_ID_INVALID;
         }
 
-        uint32_t dataIndex = reg->dataArray.count - 1;
-
-        ZuiItem *item = ZuiPushDynArray(&g_zui_ctx->items, &g_zui_arena);
+        ZuiItem *item = ZuiAllocItemSlot();
         if (!item)
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate item");
             return ZUI_ID_INVALID;
         }
 
-        uint32_t itemId = g_zui_ctx->items.count - 1;
-
-        memset(item, 0, sizeof(ZuiItem));
-        item->id = itemId;
+        uint32_t itemId = item->id;
         item->type = typeId;
         item->dataIndex = dataIndex;
-        item->parentId = ZUI_ID_INVALID;
-        item->isContainer = false;
-        item->canMove = false;
 
         if (reg->init)
         {
@@ -3785,11 +6807,11 @@ extern "C"
 
     ZuiTypeRegistration *ZuiGetTypeRegistration(uint32_t typeId)
     {
-        if (!g_zui_ctx || typeId >= 16)
+        if (!g_zui_ctx || typeId >= g_zui_ctx->typeRegistry.registrations.count)
         {
             return NULL;
         }
-        return &g_zui_ctx->typeRegistry.registrations[typeId];
+        return ZuiTypeRegistrationPageAt(&g_zui_ctx->typeRegistry.registrations, typeId);
     }
 
     const ZuiTypeRegistration *ZuiGetTypeInfo(uint32_t typeId)
@@ -3808,6 +6830,7 @@ extern "C"
         info.update = reg->update;
         info.render = reg->render;
         info.init = reg->init;
+        info.alwaysUpdate = reg->alwaysUpdate;
         return &info;
     }
 
@@ -3834,7 +6857,7 @@ extern "C"
 
     const void *ZuiGetTypedDataConst(uint32_t itemId) { return ZuiGetTypedData(itemId); }
 
-    ZuiResult ZuiInitRegistryEntry(ZuiDynArray *dataArray, ZuiTypeRegistration *entry, uint32_t id,
+    ZuiResult ZuiInitRegistryEntry(ZuiPagedArray *dataArray, ZuiTypeRegistration *entry, uint32_t id,
                                    const char *name, size_t dataSize,
                                    size_t dataAlignment, uint32_t capacity)
     {
@@ -3850,8 +6873,8 @@ extern "C"
         entry->id = id;
 
         uint32_t actualCapacity = capacity > 0 ? capacity : 32;
-        ZuiResult result = ZuiInitDynArray(dataArray, &g_zui_arena,
-                                           actualCapacity, dataSize, dataAlignment, name);
+        ZuiResult result = ZuiInitPagedArray(dataArray, &g_zui_arena,
+                                             actualCapacity, dataSize, dataAlignment, name);
         if (result != ZUI_OK)
         {
             return result;
@@ -3861,7 +6884,7 @@ extern "C"
         return ZUI_OK;
     }
 
-    void *ZuiGetRegistryData(ZuiDynArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex)
+    void *ZuiGetRegistryData(ZuiPagedArray *dataArray, const ZuiTypeRegistration *entry, uint32_t dataIndex)
     {
         if (!entry)
         {
@@ -3874,17 +6897,17 @@ extern "C"
                              dataIndex, entry->name);
             return NULL;
         }
-        return ZuiGetDynArray(dataArray, dataIndex);
+        return ZuiGetPagedArray(dataArray, dataIndex);
     }
 
-    void *ZuiAllocRegistryData(ZuiDynArray *dataArray, ZuiTypeRegistration *entry)
+    void *ZuiAllocRegistryData(ZuiPagedArray *dataArray, ZuiTypeRegistration *entry)
     {
         if (!entry)
         {
             return NULL;
         }
 
-        void *data = ZuiPushDynArray(dataArray, &g_zui_arena);
+        void *data = ZuiPushPagedArray(dataArray, &g_zui_arena);
         if (!data)
         {
             ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY,
@@ -3896,21 +6919,73 @@ extern "C"
     // -----------------------------------------------------------------------------
     // zui_item.c
 
+    uint32_t ZuiItemIdIndex(uint32_t id) { return id & ZUI_ID_INDEX_MASK; }
+
+    uint32_t ZuiItemIdGeneration(uint32_t id) { return id >> ZUI_ID_INDEX_BITS; }
+
+    // O(1): the slot must exist and still carry the same generation
+    static ZuiItem *ZuiLookupItem(const uint32_t id, const bool report)
+    {
+        const uint32_t index = id & ZUI_ID_INDEX_MASK;
+        if (id == ZUI_ID_INVALID || index >= g_zui_ctx->items.count)
+        {
+            if (report)
+            {
+                ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_BOUNDS,
+                                 "Item index %u out of bounds (count: %u)", index, g_zui_ctx->items.count);
+            }
+            return NULL;
+        }
+
+        ZuiItem *item = ZuiItemArrayGet(&g_zui_ctx->items, index);
+        if (!item || item->id != id)
+        {
+            if (report)
+            {
+                ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Stale item id %u (generation %u)",
+                                 id, ZuiItemIdGeneration(id));
+            }
+            return NULL;
+        }
+        return item;
+    }
+
+#ifndef ZUI_FAST
     const ZuiItem *ZuiGetItem(uint32_t id)
     {
         if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
         {
             return NULL;
         }
+        return ZuiLookupItem(id, true);
+    }
+#endif
 
-        if (id >= g_zui_ctx->items.count)
+    // Keeps the pre-scope state of an item so ZuiEndTransientScope can put it back
+    static void ZuiJournalItem(const ZuiItem *item)
+    {
+        ZuiTransientScope *scope = &g_zui_ctx->transient;
+        const ZuiItem *entries = (const ZuiItem *)scope->journal.items;
+        for (uint32_t i = 0; i < scope->journal.count; i++)
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_BOUNDS,
-                             "Item index %u out of bounds (count: %u)", id, g_zui_ctx->items.count);
-            return NULL;
+            if (entries[i].id == item->id)
+            {
+                return;
+            }
+        }
+
+        if (!scope->journal.items &&
+            ZuiInitDynArray(&scope->journal, &g_zui_arena, ZUI_ITEMS_CAPACITY,
+                            sizeof(ZuiItem), ZUI_ALIGNOF(ZuiItem), "Journal") != ZUI_OK)
+        {
+            return;
         }
 
-        return (ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, id);
+        ZuiItem *entry = ZuiItemArrayPush(&scope->journal, &g_zui_arena);
+        if (entry)
+        {
+            *entry = *item;
+        }
     }
 
     ZuiItem *ZuiGetItemMut(uint32_t id)
@@ -3920,14 +6995,56 @@ extern "C"
             return NULL;
         }
 
-        if (id >= g_zui_ctx->items.count)
+        ZuiItem *item = ZuiLookupItem(id, true);
+        if (item && ZuiIsPreScopeItem(id))
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_BOUNDS,
-                             "Item index %u out of bounds (count: %u)", id, g_zui_ctx->items.count);
-            return NULL;
+            ZuiJournalItem(item);
+        }
+        return item;
+    }
+
+    // Dirty flags are not structural, so the walk skips the scope journal and stops at the first flagged ancestor
+    void ZuiMarkDirty(uint32_t id)
+    {
+        if (!g_zui_ctx)
+        {
+            return;
+        }
+        ZuiItem *item = ZuiLookupItem(id, false);
+        if (!item)
+        {
+            return;
         }
+        item->dirtyFlags |= ZUI_DIRTY_SELF;
 
-        return (ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, id);
+        uint32_t parentId = item->parentId;
+        while (parentId != ZUI_ID_INVALID)
+        {
+            ZuiItem *parent = ZuiLookupItem(parentId, false);
+            if (!parent || (parent->dirtyFlags & ZUI_DIRTY_CHILDREN))
+            {
+                break;
+            }
+            parent->dirtyFlags |= ZUI_DIRTY_CHILDREN;
+            parentId = parent->parentId;
+        }
+    }
+
+    bool ZuiIsItemAlive(uint32_t id)
+    {
+        return g_zui_ctx != NULL && ZuiLookupItem(id, false) != NULL;
+    }
+
+    uint32_t ZuiItemFirstChild(const uint32_t id)
+    {
+        const ZuiItem *item = ZuiGetItem(id);
+        return item ? item->firstChild : ZUI_ID_INVALID;
+    }
+
+    uint32_t ZuiItemNextSibling(const uint32_t id)
+    {
+        const ZuiItem *item = ZuiGetItem(id);
+        return item ? item->nextSibling : ZUI_ID_INVALID;
     }
 
     ZuiResult ZuiItemAddChild(const uint32_t parentId, const uint32_t childId)
@@ -3935,69 +7052,263 @@ extern "C"
         ZuiItem *parent = ZuiGetItemMut(parentId);
         ZuiItem *child = ZuiGetItemMut(childId);
 
-        if (!parent || !child || !parent->isContainer)
+        if (!parent || !child || !parent->isContainer || parentId == childId)
+        {
+            return ZUI_ERROR_CIRCULAR_REFERENCE;
+        }
+
+        // Inherit parent layer automatically
+        const ZuiLayerData *parentLayer = (const ZuiLayerData *)ZuiItemGetComponent(parentId, ZUI_COMPONENT_LAYER);
+        if (parentLayer)
+        {
+            ZuiLayerData *childLayer = (ZuiLayerData *)ZuiItemGetComponent(childId, ZUI_COMPONENT_LAYER);
+            if (!childLayer)
+            {
+                childLayer = (ZuiLayerData *)ZuiItemAddComponent(childId, ZUI_COMPONENT_LAYER);
+            }
+
+            if (childLayer)
+            {
+                // Child gets same layer, order + 1
+                if (childLayer->layer < parentLayer->layer ||
+                    (childLayer->layer == parentLayer->layer && childLayer->order <= parentLayer->order))
+                {
+                    childLayer->layer = parentLayer->layer;
+                    childLayer->order = parentLayer->order + 1;
+                }
+            }
+        }
+
+        const Vector2 oldOrigin = ZuiGetParentOrigin(childId);
+
+        // Re-parenting moves the child instead of linking it into two lists
+        if (child->parentId != ZUI_ID_INVALID)
+        {
+            ZuiItem *oldParent = ZuiGetItemMut(child->parentId);
+            if (oldParent)
+            {
+                ZuiUnlinkChild(oldParent, child);
+            }
+        }
+
+        ZuiAppendChild(parent, child);
+        child->parentId = parentId;
+        ZuiRebaseTransform(childId, oldOrigin);
+        ZuiMarkDirty(childId);
+        ZuiInvalidateLayout(childId);
+        return ZUI_OK;
+    }
+
+    uint32_t ZuiCreateItem(const ZuiItemType type, const uint32_t dataIndex)
+    {
+        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
+        ZuiItem *item = ZuiAllocItemSlot();
+        if (!item)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate item");
+            return ZUI_ID_INVALID;
+        }
+
+        item->type = type;
+        item->dataIndex = dataIndex;
+        return item->id;
+    }
+
+    ZuiResult ZuiItemRemoveChild(const uint32_t parentId, const uint32_t childId)
+    {
+        ZuiItem *parent = ZuiGetItemMut(parentId);
+        if (!parent || !parent->isContainer)
+        {
+            return ZUI_ERROR_INVALID_ID;
+        }
+
+        ZuiItem *child = ZuiGetItemMut(childId);
+        if (!child || child->parentId != parentId)
+        {
+            return ZUI_ERROR_INVALID_ID;
+        }
+
+        const Vector2 oldOrigin = ZuiGetParentOrigin(childId);
+        ZuiUnlinkChild(parent, child);
+        child->parentId = ZUI_ID_INVALID;
+        ZuiRebaseTransform(childId, oldOrigin);
+        ZuiInvalidateLayout(parentId);
+        return ZUI_OK;
+    }
+
+    // Drops context and focus-chain references so nothing keeps pointing at a dead id
+    static void ZuiReleaseItemReferences(const uint32_t id, const uint32_t parentId)
+    {
+        if (g_zui_ctx->g_focusContext.currentFocus == id)
+        {
+            ZuiUnfocusItem(id);
+            g_zui_ctx->g_focusContext.currentFocus = UINT_MAX;
+        }
+        if (g_zui_ctx->g_focusContext.rootFocus == id)
+        {
+            g_zui_ctx->g_focusContext.rootFocus = UINT_MAX;
+        }
+
+        const ZuiFocusData *focus = (const ZuiFocusData *)ZuiItemGetComponent(id, ZUI_COMPONENT_FOCUS);
+        if (focus)
+        {
+            const uint32_t next = focus->nextItem == id ? ZUI_ID_INVALID : focus->nextItem;
+            const uint32_t prev = focus->prevItem == id ? ZUI_ID_INVALID : focus->prevItem;
+            ZuiFocusData *prevFocus = ZuiIsItemAlive(prev)
+                                          ? (ZuiFocusData *)ZuiItemGetComponent(prev, ZUI_COMPONENT_FOCUS)
+                                          : NULL;
+            ZuiFocusData *nextFocus = ZuiIsItemAlive(next)
+                                          ? (ZuiFocusData *)ZuiItemGetComponent(next, ZUI_COMPONENT_FOCUS)
+                                          : NULL;
+            if (prevFocus && prevFocus->nextItem == id)
+            {
+                prevFocus->nextItem = next;
+            }
+            if (nextFocus && nextFocus->prevItem == id)
+            {
+                nextFocus->prevItem = prev;
+            }
+        }
+
+        ZuiCursor *cursor = &g_zui_ctx->cursor;
+        if (cursor->activeFrame == id)
+        {
+            cursor->activeFrame = parentId != ZUI_ID_INVALID ? parentId : cursor->rootItem;
+        }
+        if (cursor->parentFrame == id)
+        {
+            cursor->parentFrame = parentId != ZUI_ID_INVALID ? parentId : cursor->rootItem;
+        }
+        if (cursor->activeItem == id)
+        {
+            cursor->activeItem = ZUI_ID_INVALID;
+        }
+
+        ZuiMenuContext *menu = &g_zui_ctx->g_menuContext;
+        if (menu->activeMenuBar == id)
+        {
+            menu->activeMenuBar = ZUI_ID_INVALID;
+        }
+        if (menu->activeMenu == id)
+        {
+            menu->activeMenu = ZUI_ID_INVALID;
+        }
+        if (menu->hoveredItem == id)
+        {
+            menu->hoveredItem = ZUI_ID_INVALID;
+        }
+        if (menu->lastMenuItem == id)
+        {
+            menu->lastMenuItem = ZUI_ID_INVALID;
+        }
+
+        if (g_zui_ctx->windowManager.focusedWindow == id)
+        {
+            g_zui_ctx->windowManager.focusedWindow = ZUI_ID_INVALID;
+        }
+    }
+
+    ZuiResult ZuiDestroyItem(uint32_t id)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
+
+        ZuiItem *item = ZuiGetItemMut(id);
+        if (!item)
+        {
+            return ZUI_ERROR_INVALID_ID;
+        }
+
+        if (id == g_zui_ctx->cursor.rootItem)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Cannot destroy the root item");
+            return ZUI_ERROR_INVALID_STATE;
+        }
+
+        if (item->childCount > 0)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE,
+                             "Item %u still has %u children, use ZuiDestroySubtree", id, item->childCount);
+            return ZUI_ERROR_INVALID_STATE;
+        }
+
+        if (ZuiIsPreScopeItem(id))
         {
-            return ZUI_ERROR_CIRCULAR_REFERENCE;
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Item %u was created before the transient scope", id);
+            return ZUI_ERROR_INVALID_STATE;
         }
 
-        // Inherit parent layer automatically
-        const ZuiLayerData *parentLayer = (const ZuiLayerData *)ZuiItemGetComponent(parentId, ZUI_COMPONENT_LAYER);
-        if (parentLayer)
+        const uint32_t parentId = item->parentId;
+        if (parentId != ZUI_ID_INVALID)
         {
-            ZuiLayerData *childLayer = (ZuiLayerData *)ZuiItemGetComponent(childId, ZUI_COMPONENT_LAYER);
-            if (!childLayer)
-            {
-                childLayer = (ZuiLayerData *)ZuiItemAddComponent(childId, ZUI_COMPONENT_LAYER);
-            }
+            ZuiItemRemoveChild(parentId, id);
+        }
+        ZuiReleaseItemReferences(id, parentId);
 
-            if (childLayer)
+        // Free lists below may allocate, re-fetch the slot afterwards
+        const uint32_t index = id & ZUI_ID_INDEX_MASK;
+        const ZuiItem released = *item;
+
+        for (uint32_t i = 0; i < released.componentCount; i++)
+        {
+            ZuiComponentRegistration *reg = ZuiGetComponentRegistration(released.components[i].componentId);
+            if (reg && released.components[i].dataIndex < reg->dataArray.count)
             {
-                // Child gets same layer, order + 1
-                if (childLayer->layer < parentLayer->layer ||
-                    (childLayer->layer == parentLayer->layer && childLayer->order <= parentLayer->order))
-                {
-                    childLayer->layer = parentLayer->layer;
-                    childLayer->order = parentLayer->order + 1;
-                }
+                ZuiReleaseComponentData(reg, released.components[i].dataIndex, index);
             }
         }
 
-        uint32_t *childIdSlot = (uint32_t *)ZuiPushDynArray(&parent->children, &g_zui_arena);
-        if (!childIdSlot)
+        ZuiTypeRegistration *typeReg = ZuiGetTypeRegistration(released.type);
+        void *typeData = typeReg && typeReg->dataArray.pages.items ? ZuiGetPagedArray(&typeReg->dataArray, released.dataIndex) : NULL;
+        if (typeData)
         {
-            return ZUI_ERROR_OUT_OF_MEMORY;
+            if (released.type == ZUI_LABEL)
+            {
+                ZuiReleaseString(&g_zui_ctx->strings, ((const ZuiLabelData *)typeData)->text);
+            }
+            memset(typeData, 0, typeReg->dataSize);
+            ZuiPushFreeIndex(&typeReg->freeSlots, released.dataIndex, "FreeSlots");
         }
 
-        *childIdSlot = childId;
-        child->parentId = parentId;
-        return ZUI_OK;
+        item = ZuiItemArrayGet(&g_zui_ctx->items, index);
+        ZuiResetItemSlot(item, released.generation);
+
+        return ZuiPushFreeIndex(&g_zui_ctx->freeItems, index, "FreeItems");
     }
 
-    uint32_t ZuiCreateItem(const ZuiItemType type, const uint32_t dataIndex)
+    ZuiResult ZuiDestroySubtree(uint32_t id)
     {
-        ZUI_ASSERT_CTX_RETURN_ID_INVALID();
-        ZuiItem *item = (ZuiItem *)ZuiPushDynArray(&g_zui_ctx->items, &g_zui_arena);
-        if (!item)
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
         {
-            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to allocate item");
-            return ZUI_ID_INVALID;
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
+        if (!ZuiGetItem(id))
+        {
+            return ZUI_ERROR_INVALID_ID;
         }
 
-        uint32_t item_id = g_zui_ctx->items.count - 1;
-
-        *item = (ZuiItem){
-            .id = item_id,
-            .parentId = ZUI_ID_INVALID,
-            .type = type,
-            .dataIndex = dataIndex,
-            .children = (ZuiDynArray){0},
-            .componentMask = 0,
-            .componentCount = 0,
-            .isContainer = false,
-            .canMove = false,
-        };
+        // Post-order, children detach themselves before their parent goes
+        const uint32_t base = ZuiBeginWalk(id, (Rectangle){0});
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            const ZuiItem *item = ZuiGetItem(entry.id);
+            if (!entry.expanded && item && item->childCount > 0)
+            {
+                ZuiExpandWalk(entry, (Rectangle){0});
+                continue;
+            }
 
-        return item_id;
+            ZuiResult result = ZuiDestroyItem(entry.id);
+            if (result != ZUI_OK)
+            {
+                ZuiEndWalk(base);
+                return result;
+            }
+        }
+        return ZUI_OK;
     }
 
     uint32_t ZuiAddChild(uint32_t id)
@@ -4009,14 +7320,46 @@ extern "C"
         return id;
     }
 
+    // Runs dirty items and descends only into subtrees that flagged a dirty descendant
     void ZuiUpdateItem(const ZuiItem *item)
     {
-        if (item)
+        if (!item)
         {
-            const ZuiTypeRegistration *reg = ZuiGetTypeRegistration(item->type);
-            if (reg && reg->update)
+            return;
+        }
+
+        // Updates may reorder or destroy siblings, so children are stacked before any of them runs
+        const uint32_t base = ZuiBeginWalk(item->id, (Rectangle){0});
+        ZuiWalkEntry entry;
+        while (ZuiPopWalk(base, &entry))
+        {
+            ZuiItem *visited = ZuiLookupItem(entry.id, false);
+            if (!visited || !visited->dirtyFlags)
+            {
+                continue;
+            }
+
+            const uint8_t flags = visited->dirtyFlags;
+            const uint32_t type = visited->type;
+            const uint32_t dataIndex = visited->dataIndex;
+            visited->dirtyFlags = 0; // updates below may mark it again for the next frame
+
+            if (flags & ZUI_DIRTY_SELF)
+            {
+                const ZuiTypeRegistration *reg = ZuiGetTypeRegistration(type);
+                if (reg && reg->update)
+                {
+                    reg->update(dataIndex);
+                }
+                if (reg && reg->alwaysUpdate)
+                {
+                    ZuiMarkDirty(entry.id); // flags the path again, ancestors were cleared on the way down
+                }
+            }
+
+            if (flags & ZUI_DIRTY_CHILDREN)
             {
-                reg->update(item->dataIndex);
+                ZuiPushWalkChildren(entry.id, ZUI_ID_INVALID);
             }
         }
     }
@@ -4072,38 +7415,11 @@ extern "C"
         return itemId;
     }
 
-    void ZuiUpdateFrame(uint32_t dataIndex)
-    {
-        ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_FRAME];
-        const ZuiFrameData *frameData = (const ZuiFrameData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
-        if (!frameData)
-        {
-            return;
-        }
-
-        const ZuiItem *frameItem = ZuiGetItem(frameData->itemId);
-        if (!frameItem || !frameItem->isContainer)
-        {
-            return;
-        }
-
-        const uint32_t *childIds = (uint32_t *)frameItem->children.items;
-        for (uint32_t i = 0; i < frameItem->children.count; i++)
-        {
-            const ZuiItem *child = ZuiGetItem(childIds[i]);
-            if (child)
-            {
-                ZuiUpdateItem(child);
-            }
-        }
-    }
-
     void ZuiRenderFrame(uint32_t dataIndex)
     {
         ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_FRAME];
-        const ZuiFrameData *frameData = (const ZuiFrameData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
+        ZuiTypeRegistration *reg = ZuiGetTypeRegistration(ZUI_FRAME);
+        const ZuiFrameData *frameData = ZuiFrameDataPageGet(&reg->dataArray, dataIndex);
         if (!frameData)
         {
             return;
@@ -4141,15 +7457,10 @@ extern "C"
                                         frameData->style.borderThickness, borderColor);
         }
 
+        // Children's world bounds already carry the scroll offset
         const ZuiScrollData *scroll = (const ZuiScrollData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_SCROLL);
         bool hasScroll = (scroll != NULL && (scroll->verticalEnabled || scroll->horizontalEnabled));
 
-        Vector2 scrollOffset = {0, 0};
-        if (hasScroll)
-        {
-            scrollOffset = scroll->offset;
-        }
-
         bool useScissor = frameData->enableScissor || hasScroll;
         if (useScissor)
         {
@@ -4171,23 +7482,12 @@ extern "C"
 
         if (frameItem->isContainer)
         {
-            const uint32_t *childIds = (uint32_t *)frameItem->children.items;
-            for (uint32_t i = 0; i < frameItem->children.count; i++)
+            for (uint32_t childId = frameItem->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
             {
-                const ZuiItem *child = ZuiGetItem(childIds[i]);
+                const ZuiItem *child = ZuiGetItem(childId);
                 if (child)
                 {
-                    if (hasScroll)
-                    {
-                        ZuiApplyScrollOffsetRecursive(childIds[i],
-                                                      (Vector2){-scrollOffset.x, -scrollOffset.y});
-                        ZuiRenderItem(child);
-                        ZuiApplyScrollOffsetRecursive(childIds[i], scrollOffset);
-                    }
-                    else
-                    {
-                        ZuiRenderItem(child);
-                    }
+                    ZuiRenderItem(child);
                 }
             }
         }
@@ -4320,6 +7620,8 @@ extern "C"
         {
             transform->offset.x += x;
             transform->offset.y += y;
+            ZuiInvalidateTransform(transform);
+            ZuiMarkDirty(transform->itemId);
             g_zui_ctx->cursor.position.x += x;
             g_zui_ctx->cursor.position.y += y;
         }
@@ -4390,26 +7692,28 @@ extern "C"
         {
             return ZUI_ID_INVALID;
         }
-        // item
-        uint32_t itemId = ZuiCreateTypedItem(ZUI_LABEL);
-        if (itemId == ZUI_ID_INVALID)
+        // text
+        const uint32_t handle = ZuiInternString(&g_zui_ctx->strings, &g_zui_arena, text);
+        if (handle == ZUI_STRING_NONE)
         {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to intern label text");
             return ZUI_ID_INVALID;
         }
-
-        // labelData
-        ZuiLabelData *labelData = (ZuiLabelData *)ZuiGetTypedData(itemId);
+        // item
+        uint32_t itemId = ZuiCreateTypedItem(ZUI_LABEL);
+        ZuiLabelData *labelData = itemId != ZUI_ID_INVALID ? (ZuiLabelData *)ZuiGetTypedData(itemId) : NULL;
         if (!labelData)
         {
+            ZuiReleaseString(&g_zui_ctx->strings, handle);
             return ZUI_ID_INVALID;
         }
         // init
         *labelData = (ZuiLabelData){
             .itemId = itemId,
             .style = style,
+            .text = handle,
         };
 
-        snprintf(labelData->text, ZUI_MAX_TEXT_LENGTH, "%s", text);
         Vector2 textSize = MeasureTextEx(labelData->style.font,
                                          text, labelData->style.fontSize, labelData->style.fontSpacing);
         Rectangle bounds = {0, 0, textSize.x, textSize.y};
@@ -4426,8 +7730,8 @@ extern "C"
     void ZuiRenderLabel(uint32_t dataIndex)
     {
         ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_LABEL];
-        const ZuiLabelData *labelData = (const ZuiLabelData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
+        ZuiTypeRegistration *reg = ZuiGetTypeRegistration(ZUI_LABEL);
+        const ZuiLabelData *labelData = ZuiLabelDataPageGet(&reg->dataArray, dataIndex);
         if (!labelData)
         {
             return;
@@ -4456,7 +7760,7 @@ extern "C"
         }
 
         // Draw text
-        DrawTextEx(labelData->style.font, labelData->text,
+        DrawTextEx(labelData->style.font, ZuiGetPooledString(&g_zui_ctx->strings, labelData->text),
                    (Vector2){bounds.x, bounds.y},
                    labelData->style.fontSize, labelData->style.fontSpacing, textColor);
     }
@@ -4492,6 +7796,7 @@ extern "C"
         if (labelData)
         {
             labelData->style.textColor = textColor;
+            ZuiMarkDirty(g_zui_ctx->cursor.activeItem);
         }
     }
 
@@ -4502,7 +7807,61 @@ extern "C"
         if (labelData)
         {
             labelData->style.textBgColor = backgroundColor;
+            ZuiMarkDirty(g_zui_ctx->cursor.activeItem);
+        }
+    }
+
+    ZuiResult ZuiLabelSetText(uint32_t itemId, const char *text)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
+
+        const ZuiItem *item = ZuiGetItem(itemId);
+        ZuiLabelData *labelData = item && item->type == ZUI_LABEL ? (ZuiLabelData *)ZuiGetTypedData(itemId) : NULL;
+        if (!labelData || !text)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_ID, "Item %u is not a label", itemId);
+            return ZUI_ERROR_INVALID_ID;
+        }
+
+        // The scope would roll the string back underneath a label that outlives it
+        if (ZuiIsPreScopeItem(itemId))
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Label %u was created before the transient scope", itemId);
+            return ZUI_ERROR_INVALID_STATE;
+        }
+
+        const uint32_t handle = ZuiInternString(&g_zui_ctx->strings, &g_zui_arena, text);
+        if (handle == ZUI_STRING_NONE)
+        {
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+
+        // Released after the intern so setting the same text keeps its entry
+        ZuiReleaseString(&g_zui_ctx->strings, labelData->text);
+        labelData->text = handle;
+        Vector2 textSize = MeasureTextEx(labelData->style.font, text, labelData->style.fontSize,
+                                         labelData->style.fontSpacing);
+        Rectangle bounds = ZuiGetTransformBounds(itemId);
+        bounds.width = textSize.x;
+        bounds.height = textSize.y;
+        ZuiSetTransformBounds(itemId, bounds);
+        ZuiInvalidateLayout(itemId);
+        return ZUI_OK;
+    }
+
+    const char *ZuiLabelGetText(uint32_t itemId)
+    {
+        if (!g_zui_ctx)
+        {
+            return "";
         }
+        const ZuiItem *item = ZuiGetItem(itemId);
+        const ZuiLabelData *labelData =
+            item && item->type == ZUI_LABEL ? (const ZuiLabelData *)ZuiGetTypedDataConst(itemId) : NULL;
+        return labelData ? ZuiGetPooledString(&g_zui_ctx->strings, labelData->text) : "";
     }
     // -----------------------------------------------------------------------------
     // zui_texture.c
@@ -4542,8 +7901,8 @@ extern "C"
     void ZuiRenderTexture(uint32_t dataIndex)
     {
         ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_TEXTURE];
-        const ZuiTextureData *texData = (const ZuiTextureData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
+        ZuiTypeRegistration *reg = ZuiGetTypeRegistration(ZUI_TEXTURE);
+        const ZuiTextureData *texData = ZuiTextureDataPageGet(&reg->dataArray, dataIndex);
         if (!texData)
         {
             return;
@@ -4950,6 +8309,7 @@ extern "C"
         g_zui_ctx->cursor.tempRestPosition = g_zui_ctx->cursor.position;
     }
 
+#ifndef ZUI_FAST
     bool ZuiEnsureContext(ZuiResult error_code, const char *msg)
     {
         if (!g_zui_ctx)
@@ -4959,8 +8319,72 @@ extern "C"
         }
         return true;
     }
+#endif
+
+    ZuiConfig ZuiDefaultConfig(void)
+    {
+        ZuiConfig config = {
+            .arenaSize = ZUI_DEFAULT_ARENA_SIZE,
+            .arenaReserve = ZUI_ARENA_RESERVE_SIZE,
+            .frameArenaSize = ZUI_FRAME_ARENA_SIZE,
+            .itemCapacity = ZUI_ITEMS_CAPACITY,
+            .growthFactor = 2.0F,
+        };
+        return config;
+    }
+
+    static size_t ZuiRoundUpSize(const size_t size, const size_t granularity)
+    {
+        return ((size + granularity - 1) / granularity) * granularity;
+    }
+
+    // Sizes every array to the peak count seen so far, so the same UI allocates each array once
+    ZuiConfig ZuiSuggestConfig(void)
+    {
+        ZuiConfig config = ZuiDefaultConfig();
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return config;
+        }
+
+        config.growthFactor = g_zui_ctx->config.growthFactor;
+        config.arenaReserve = g_zui_ctx->config.arenaReserve;
+        config.arenaSize = ZuiRoundUpSize(g_zui_arena.highWater, 65536);
+        config.frameArenaSize = ZuiRoundUpSize(g_zui_ctx->frameArena.highWater, 4096);
+        if (config.frameArenaSize == 0)
+        {
+            config.frameArenaSize = ZUI_FRAME_ARENA_SIZE;
+        }
+
+        // Slot arrays never shrink, so their count is the high-water mark
+        config.itemCapacity = g_zui_ctx->items.count;
+
+        for (uint32_t i = 0; i < ZUI_COMPONENT_COUNT; i++)
+        {
+            config.componentCapacities[i] = ZuiGetComponentRegistration(i)->dataArray.count;
+        }
+
+        for (uint32_t i = 0; i < ZUI_TYPE_COUNT; i++)
+        {
+            config.typeCapacities[i] = ZuiGetTypeRegistration(i)->dataArray.count;
+        }
+
+        return config;
+    }
+
+    // Whole budget of a heap arena, capped by the reserve like a virtual one
+    static size_t ZuiGetHeapArenaSize(const size_t size, const size_t reserve)
+    {
+        const size_t scaled = size <= SIZE_MAX / ZUI_HEAP_ARENA_SCALE ? size * ZUI_HEAP_ARENA_SCALE : size;
+        return scaled < reserve ? scaled : (reserve > size ? reserve : size);
+    }
 
     bool ZuiInit(void)
+    {
+        return ZuiInitEx(NULL);
+    }
+
+    bool ZuiInitEx(const ZuiConfig *userConfig)
     {
         if (g_zui_ctx)
         {
@@ -4968,7 +8392,40 @@ extern "C"
             return false;
         }
 
-        ZuiResult result = ZuiInitArena(&g_zui_arena, ZUI_DEFAULT_ARENA_SIZE);
+        ZuiConfig config = ZuiDefaultConfig();
+        if (userConfig)
+        {
+            const ZuiConfig defaults = config;
+            config = *userConfig;
+            config.arenaSize = config.arenaSize > 0 ? config.arenaSize : defaults.arenaSize;
+            config.arenaReserve = config.arenaReserve > 0 ? config.arenaReserve : defaults.arenaReserve;
+            config.frameArenaSize = config.frameArenaSize > 0 ? config.frameArenaSize : defaults.frameArenaSize;
+            config.itemCapacity = config.itemCapacity > 0 ? config.itemCapacity : defaults.itemCapacity;
+            if (config.growthFactor <= 1.0F)
+            {
+                if (config.growthFactor != 0.0F)
+                {
+                    ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_VALUE, "Growth factor %.2f must be > 1, using 2",
+                                     (double)config.growthFactor);
+                }
+                config.growthFactor = defaults.growthFactor;
+            }
+            if (config.arenaReserve < config.arenaSize)
+            {
+                config.arenaReserve = config.arenaSize;
+            }
+        }
+
+        // Prefer a reserve/commit arena: growth never moves the buffer (g_zui_ctx lives in it)
+        ZuiResult result = config.allocator
+                               ? ZuiInitArenaEx(&g_zui_arena, ZuiGetHeapArenaSize(config.arenaSize, config.arenaReserve),
+                                                config.allocator)
+                               : ZuiInitArenaVirtual(&g_zui_arena, config.arenaReserve, config.arenaSize);
+        if (result != ZUI_OK && !config.allocator)
+        {
+            TraceLog(LOG_WARNING, "ZUI: Virtual arena unavailable, falling back to heap arena");
+            result = ZuiInitArena(&g_zui_arena, ZuiGetHeapArenaSize(config.arenaSize, config.arenaReserve));
+        }
         if (result != ZUI_OK)
         {
             TraceLog(LOG_ERROR, "ZUI: Arena initialization failed");
@@ -4986,6 +8443,8 @@ extern "C"
         }
 
         *ctx = (ZuiContext){0};
+        ctx->config = config;
+        g_zui_arena.growthFactor = config.growthFactor;
         g_zui_ctx = ctx;
 
         ctx->g_focusContext = (ZuiFocusContext){
@@ -5000,8 +8459,12 @@ extern "C"
             .lastMenuItem = ZUI_ID_INVALID,
         };
 
-        // Initialize component registry first
+        // Initialize component and type registries first
         result = ZuiInitComponentRegistry();
+        if (result == ZUI_OK)
+        {
+            result = ZuiInitTypeRegistry();
+        }
         if (result != ZUI_OK)
         {
             TraceLog(LOG_ERROR, "ZUI: Component registry init failed");
@@ -5013,7 +8476,7 @@ extern "C"
         ZuiRegisterAllComponents();
         ZuiRegisterAllTypes();
         // items
-        result = ZuiInitDynArray(&ctx->items, &g_zui_arena, ZUI_ITEMS_CAPACITY,
+        result = ZuiInitDynArray(&ctx->items, &g_zui_arena, config.itemCapacity,
                                  sizeof(ZuiItem), ZUI_ALIGNOF(ZuiItem), "Items");
         if (result != ZUI_OK)
         {
@@ -5023,6 +8486,15 @@ extern "C"
             return false;
         }
 
+        result = ZuiInitStringPool(&ctx->strings, &g_zui_arena);
+        if (result != ZUI_OK)
+        {
+            TraceLog(LOG_ERROR, "ZUI: Failed to initialize string pool");
+            ZuiUnloadArena(&g_zui_arena);
+            g_zui_ctx = NULL;
+            return false;
+        }
+
         g_zui_ctx->cursor = (ZuiCursor){0};
         g_zui_ctx->windowManager = (ZuiWindowManager){0};
 
@@ -5030,99 +8502,221 @@ extern "C"
         uint32_t root_item =
             ZuiCreateFrame((Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()}, frameStyle);
 
-        if (root_item == ZUI_ID_INVALID || !ZuiItemHasComponent(root_item, ZUI_COMPONENT_TRANSFORM))
+        if (root_item == ZUI_ID_INVALID || !ZuiItemHasComponent(root_item, ZUI_COMPONENT_TRANSFORM))
+        {
+            TraceLog(LOG_ERROR, "ZUI: Failed to create root frame");
+            ZuiUnloadArena(&g_zui_arena);
+            g_zui_ctx = NULL;
+            return false;
+        }
+
+        ZuiItemSetLayout(root_item, ZUI_LAYOUT_VERTICAL);
+        ZuiLayoutSetSpacing(root_item, 0);
+        ZuiLayoutSetPadding(root_item, 0);
+        float pad = ZuiGetFramePadding(root_item);
+        g_zui_ctx->cursor.position = (Vector2){pad, pad};
+        g_zui_ctx->cursor.restPosition = g_zui_ctx->cursor.position;
+        g_zui_ctx->cursor.activeFrame = root_item;
+        g_zui_ctx->cursor.rootItem = root_item;
+
+        Vector2 dpiScale = GetWindowScaleDPI();
+        g_zui_ctx->dpiScale = (int)dpiScale.x;
+        if (g_zui_ctx->dpiScale <= 0)
+        {
+            g_zui_ctx->dpiScale = ZUI_DEFAULT_DPI_SCALE;
+        }
+
+        if (config.allocator)
+        {
+            result = ZuiInitArenaEx(&g_zui_ctx->frameArena,
+                                    ZuiGetHeapArenaSize(config.frameArenaSize, config.arenaReserve), config.allocator);
+        }
+        else
+        {
+            result = ZuiInitArenaVirtual(&g_zui_ctx->frameArena, config.arenaReserve, config.frameArenaSize);
+            if (result != ZUI_OK)
+            {
+                // Heap fallback is fixed size, frame allocations fail once it is full
+                result = ZuiInitArena(&g_zui_ctx->frameArena,
+                                      ZuiGetHeapArenaSize(config.frameArenaSize, config.arenaReserve));
+            }
+        }
+        if (result != ZUI_OK)
+        {
+            TraceLog(LOG_ERROR, "ZUI: Frame arena initialization failed");
+            ZuiUnloadArena(&g_zui_arena);
+            g_zui_ctx = NULL;
+            return false;
+        }
+
+        result = ZuiInitTheme(&g_zui_ctx->defaultTheme, g_zui_ctx->dpiScale);
+        if (result != ZUI_OK)
+        {
+            TraceLog(LOG_WARNING, "ZUI: Failed to initialize theme, using fallback colors");
+        }
+
+        TraceLog(LOG_INFO, "ZUI: Initialized successfully");
+        return true;
+    }
+
+    static void ZuiWriteWorldLane(ZuiWorldLanes *lanes, const uint32_t itemId)
+    {
+        const uint32_t index = itemId & ZUI_ID_INDEX_MASK;
+        const ZuiItem *item = ZuiLookupItem(itemId, false);
+        if (!item || index >= lanes->bounds.count ||
+            !(item->componentMask & ZUI_COMPONENT_BIT(ZUI_COMPONENT_TRANSFORM)))
+        {
+            return; // destroyed since, a reused slot is queued by its own transform
+        }
+        ZuiSetBoundsSoA(&lanes->bounds, index, ZuiGetTransformBounds(itemId));
+        lanes->ids[index] = itemId;
+    }
+
+    // Brings the lanes up to date with the world caches, only invalidated items are resolved unless they need a
+    // rebuild. Growth allocates fresh lanes and rebuilds them, the old blocks go back to the arena
+    static const ZuiBoundsSoA *ZuiRefreshWorldLanes(void)
+    {
+        ZuiWorldLanes *lanes = &g_zui_ctx->worldLanes;
+        const uint32_t itemCount = g_zui_ctx->items.count;
+        if (itemCount > lanes->bounds.count && itemCount <= lanes->failedCount)
+        {
+            return NULL; // hit tests fall back to scalar checks instead of retrying every frame
+        }
+        if (itemCount > lanes->bounds.count)
+        {
+            const uint32_t oldCount = lanes->bounds.count;
+            float *oldLanes[] = {lanes->bounds.x, lanes->bounds.y, lanes->bounds.width, lanes->bounds.height};
+            uint32_t *oldIds = lanes->ids;
+
+            const uint32_t count = itemCount > oldCount * 2 ? itemCount : oldCount * 2;
+            ZuiBoundsSoA bounds = {0};
+            if (ZuiInitBoundsSoA(&bounds, &g_zui_arena, count) != ZUI_OK)
+            {
+                lanes->failedCount = itemCount;
+                return NULL;
+            }
+            uint32_t *ids = (uint32_t *)ZuiAllocArena(&g_zui_arena, sizeof(uint32_t) * bounds.count,
+                                                      ZUI_ALIGNOF(uint32_t));
+            if (!ids)
+            {
+                float *newLanes[] = {bounds.x, bounds.y, bounds.width, bounds.height};
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    ZuiFreeArenaBlock(&g_zui_arena, newLanes[i], sizeof(float) * bounds.count, "WorldLanes");
+                }
+                lanes->failedCount = itemCount;
+                return NULL;
+            }
+
+            for (uint32_t i = 0; oldCount > 0 && i < 4; i++)
+            {
+                ZuiFreeArenaBlock(&g_zui_arena, oldLanes[i], sizeof(float) * oldCount, "WorldLanes");
+            }
+            ZuiFreeArenaBlock(&g_zui_arena, oldIds, sizeof(uint32_t) * oldCount, "WorldLanes");
+            lanes->bounds = bounds;
+            lanes->ids = ids;
+            lanes->rebuild = true;
+            lanes->failedCount = 0;
+        }
+
+        if (lanes->rebuild)
         {
-            TraceLog(LOG_ERROR, "ZUI: Failed to create root frame");
-            ZuiUnloadArena(&g_zui_arena);
-            g_zui_ctx = NULL;
-            return false;
+            for (uint32_t i = 0; i < lanes->bounds.count; i++)
+            {
+                ZuiSetBoundsSoA(&lanes->bounds, i, (Rectangle){0});
+                lanes->ids[i] = ZUI_ID_INVALID;
+            }
+            const ZuiComponentRegistration *reg = ZuiGetComponentRegistration(ZUI_COMPONENT_TRANSFORM);
+            for (uint32_t dense = 0; dense < reg->dataArray.count && dense < reg->owners.count; dense++)
+            {
+                ZuiWriteWorldLane(lanes, ((const uint32_t *)reg->owners.items)[dense]);
+            }
+            lanes->rebuild = false;
         }
-
-        ZuiItemSetLayout(root_item, ZUI_LAYOUT_VERTICAL);
-        ZuiLayoutSetSpacing(root_item, 0);
-        ZuiLayoutSetPadding(root_item, 0);
-        float pad = ZuiGetFramePadding(root_item);
-        g_zui_ctx->cursor.position = (Vector2){pad, pad};
-        g_zui_ctx->cursor.restPosition = g_zui_ctx->cursor.position;
-        g_zui_ctx->cursor.activeFrame = root_item;
-        g_zui_ctx->cursor.rootItem = root_item;
-
-        Vector2 dpiScale = GetWindowScaleDPI();
-        g_zui_ctx->dpiScale = (int)dpiScale.x;
-        if (g_zui_ctx->dpiScale <= 0)
+        else
         {
-            g_zui_ctx->dpiScale = ZUI_DEFAULT_DPI_SCALE;
+            for (uint32_t i = 0; i < lanes->stale.count; i++)
+            {
+                ZuiWriteWorldLane(lanes, ((const uint32_t *)lanes->stale.items)[i]);
+            }
         }
+        lanes->stale.count = 0;
+        return &lanes->bounds;
+    }
 
-        result = ZuiInitTheme(&g_zui_ctx->defaultTheme, g_zui_ctx->dpiScale);
-        if (result != ZUI_OK)
+    // Falls back to a scalar test for items whose lane was written for an earlier owner of the slot,
+    // created during this update after the lanes were refreshed
+    static bool ZuiHitTestLanes(const uint8_t *hitMasks, const uint32_t itemId, const Vector2 point)
+    {
+        const ZuiWorldLanes *lanes = &g_zui_ctx->worldLanes;
+        const uint32_t index = itemId & ZUI_ID_INDEX_MASK;
+        if (hitMasks && index < lanes->bounds.count && lanes->ids[index] == itemId)
         {
-            TraceLog(LOG_WARNING, "ZUI: Failed to initialize theme, using fallback colors");
+            return ZuiBoundsSoAHit(hitMasks, index);
         }
-
-        TraceLog(LOG_INFO, "ZUI: Initialized successfully");
-        return true;
+        return CheckCollisionPointRec(point, ZuiGetTransformBounds(itemId));
     }
 
     void ZuiUpdateComponents(void)
     {
         ZUI_ASSERT_CTX_RETURN();
+        g_zui_ctx->iterationDepth++; // systems hold removals back until the custom ones have run
         float deltaTime = GetFrameTime();
         const Vector2 mousePos = GetMousePosition();
         const bool mousePressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
         const bool mouseDown = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
         const bool mouseReleased = IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
 
+        // Test the persistent lanes once, both passes read the batch hit masks by item slot
+        const ZuiBoundsSoA *lanes = ZuiRefreshWorldLanes();
+        uint8_t *hitMasks = lanes && lanes->count > 0 ? ZUI_FRAME_ALLOC_ARRAY(uint8_t, lanes->count / 8) : NULL;
+        if (hitMasks)
+        {
+            ZuiHitTestBatch(lanes, mousePos, hitMasks);
+        }
+
         uint32_t topItemId = ZUI_ID_INVALID;
+        uint32_t topIndex = 0;
         if (mousePressed || mouseDown || mouseReleased)
         {
             int highestZ = INT_MIN;
-            for (uint32_t i = 0; i < g_zui_ctx->items.count; i++)
+            ZuiQuery hits = ZuiQueryBegin(ZUI_COMPONENT_BIT(ZUI_COMPONENT_INTERACTION));
+            while (ZuiQueryNext(&hits))
             {
-                const ZuiItem *item = (const ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, i);
-                if (!item || !(item->componentMask & (1U << (uint32_t)ZUI_COMPONENT_INTERACTION)))
-                {
-                    continue;
-                }
+                const uint32_t itemId = hits.itemId;
+                const uint32_t i = itemId & ZUI_ID_INDEX_MASK; // later slots win ties
 
-                const ZuiStateData *state = (const ZuiStateData *)ZuiItemGetComponent(i, ZUI_COMPONENT_STATE);
+                const ZuiStateData *state = (const ZuiStateData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_STATE);
                 if (state && !state->isVisible)
                 {
                     continue;
                 }
 
-                Rectangle bounds = ZuiGetTransformBounds(i);
-                if (!CheckCollisionPointRec(mousePos, bounds))
+                const bool hitTest = ZuiHitTestLanes(hitMasks, itemId, mousePos);
+                if (!hitTest)
                 {
                     continue;
                 }
 
-                const ZuiLayerData *layer = (const ZuiLayerData *)ZuiItemGetComponent(i, ZUI_COMPONENT_LAYER);
+                const ZuiLayerData *layer = (const ZuiLayerData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYER);
                 int z = layer ? ((layer->layer * 1000000) + layer->order) : ZUI_LAYER_CONTENT;
 
-                if (z > highestZ || (z == highestZ && i > topItemId))
+                if (z > highestZ || (z == highestZ && i > topIndex))
                 {
                     highestZ = z;
-                    topItemId = i;
+                    topItemId = itemId;
+                    topIndex = i;
                 }
             }
         }
 
-        for (uint32_t i = 0; i < g_zui_ctx->items.count; i++)
+        ZuiQuery interactions = ZuiQueryBegin(ZUI_COMPONENT_BIT(ZUI_COMPONENT_INTERACTION));
+        while (ZuiQueryNext(&interactions))
         {
-            const ZuiItem *item = (const ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, i);
-            if (!(item->componentMask & (1U << (uint32_t)ZUI_COMPONENT_INTERACTION)))
-            {
-                continue;
-            }
-
-            ZuiInteractionData *interaction = (ZuiInteractionData *)ZuiItemGetComponent(i, ZUI_COMPONENT_INTERACTION);
-            if (!interaction)
-            {
-                continue;
-            }
+            const uint32_t itemId = interactions.itemId;
+            ZuiInteractionData *interaction = (ZuiInteractionData *)interactions.components[ZUI_COMPONENT_INTERACTION];
 
-            const ZuiStateData *state = (const ZuiStateData *)ZuiItemGetComponent(i, ZUI_COMPONENT_STATE);
+            const ZuiStateData *state = (const ZuiStateData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_STATE);
             if (state && !state->isVisible)
             {
                 continue;
@@ -5130,15 +8724,18 @@ extern "C"
 
             interaction->wasHovered = interaction->isHovered;
             interaction->wasPressed = interaction->isPressed;
-            Rectangle bounds = ZuiGetTransformBounds(i);
-            bool hitTest = CheckCollisionPointRec(mousePos, bounds);
+            const bool hitTest = ZuiHitTestLanes(hitMasks, itemId, mousePos);
             bool allowInteraction = !mousePressed && !mouseDown && !mouseReleased;
-            allowInteraction = allowInteraction || (i == topItemId) || !hitTest;
+            allowInteraction = allowInteraction || (itemId == topItemId) || !hitTest;
 
             if (!allowInteraction && interaction->blocksInput)
             {
                 interaction->isHovered = false;
                 interaction->isPressed = false;
+                if (interaction->wasHovered || interaction->wasPressed)
+                {
+                    ZuiMarkDirty(itemId);
+                }
                 continue;
             }
             interaction->isHovered = hitTest && allowInteraction;
@@ -5147,18 +8744,18 @@ extern "C"
             if (interaction->isHovered && !interaction->wasHovered)
             {
                 interaction->hoverTime = 0.0F;
-                ZuiAnimSetTarget(i, ZUI_ANIM_SLOT_HOVER, 1.0F);
+                ZuiAnimSetTarget(itemId, ZUI_ANIM_SLOT_HOVER, 1.0F);
                 if (interaction->onHoverEnter)
                 {
-                    interaction->onHoverEnter(i);
+                    interaction->onHoverEnter(itemId);
                 }
             }
             else if (!interaction->isHovered && interaction->wasHovered)
             {
-                ZuiAnimSetTarget(i, ZUI_ANIM_SLOT_HOVER, 0.0F);
+                ZuiAnimSetTarget(itemId, ZUI_ANIM_SLOT_HOVER, 0.0F);
                 if (interaction->onHoverExit)
                 {
-                    interaction->onHoverExit(i);
+                    interaction->onHoverExit(itemId);
                 }
             }
 
@@ -5172,10 +8769,10 @@ extern "C"
                 interaction->isPressed = true;
                 interaction->pressTime = 0.0F;
                 interaction->pressedButton = ZUI_MOUSE_LEFT;
-                ZuiAnimSetTarget(i, ZUI_ANIM_SLOT_PRESS, 1.0F);
+                ZuiAnimSetTarget(itemId, ZUI_ANIM_SLOT_PRESS, 1.0F);
                 if (interaction->onPress)
                 {
-                    interaction->onPress(i, ZUI_MOUSE_LEFT);
+                    interaction->onPress(itemId, ZUI_MOUSE_LEFT);
                 }
             }
 
@@ -5185,183 +8782,486 @@ extern "C"
                 if (mouseReleased)
                 {
                     interaction->isPressed = false;
-                    ZuiAnimSetTarget(i, ZUI_ANIM_SLOT_PRESS, 0.0F);
+                    ZuiAnimSetTarget(itemId, ZUI_ANIM_SLOT_PRESS, 0.0F);
                     if (interaction->onRelease)
                     {
-                        interaction->onRelease(i, interaction->pressedButton);
+                        interaction->onRelease(itemId, interaction->pressedButton);
                     }
                     if (interaction->isHovered && interaction->onClick)
                     {
-                        interaction->onClick(i, interaction->pressedButton);
+                        interaction->onClick(itemId, interaction->pressedButton);
                     }
                 }
             }
+
+            if (interaction->isHovered != interaction->wasHovered || interaction->isPressed != interaction->wasPressed)
+            {
+                ZuiMarkDirty(itemId);
+            }
         }
 
-        for (uint32_t i = 0; i < g_zui_ctx->items.count; i++)
+        ZuiQuery animations = ZuiQueryBegin(ZUI_COMPONENT_BIT(ZUI_COMPONENT_ANIMATION));
+        while (ZuiQueryNext(&animations))
         {
-            const ZuiItem *item = (const ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, i);
-
-            if (item->componentMask & (1U << (uint32_t)ZUI_COMPONENT_ANIMATION))
+            ZuiAnimationData *animData = (ZuiAnimationData *)animations.components[ZUI_COMPONENT_ANIMATION];
+            if (animData->activeCount > 0)
             {
-                ZuiAnimationData *animData = (ZuiAnimationData *)ZuiItemGetComponent(i, ZUI_COMPONENT_ANIMATION);
-                if (animData && animData->activeCount > 0)
+                if (animData->slots[ZUI_ANIM_SLOT_OFFSET_X].active || animData->slots[ZUI_ANIM_SLOT_OFFSET_Y].active ||
+                    animData->slots[ZUI_ANIM_SLOT_SCALE].active)
                 {
-                    for (uint32_t j = 0; j < ZUI_ANIM_SLOT_COUNT; j++)
+                    ZuiInvalidateWorldBounds(animations.itemId);
+                }
+                for (uint32_t j = 0; j < ZUI_ANIM_SLOT_COUNT; j++)
+                {
+                    ZuiAnimation *anim = &animData->slots[j];
+                    if (anim->active)
                     {
-                        ZuiAnimation *anim = &animData->slots[j];
-                        if (anim->active)
+                        ZuiUpdateAnimation(anim, deltaTime);
+                        if (!anim->active)
                         {
-                            ZuiUpdateAnimation(anim, deltaTime);
-                            if (!anim->active)
-                            {
-                                animData->activeCount--;
-                            }
+                            animData->activeCount--;
                         }
                     }
                 }
             }
+        }
 
-            if (item->componentMask & (1U << (uint32_t)ZUI_COMPONENT_SCROLL))
-            {
-                ZuiScrollData *scroll = (ZuiScrollData *)ZuiItemGetComponent(i, ZUI_COMPONENT_SCROLL);
-                if (!scroll)
-                {
-                    continue;
-                }
+        ZuiQuery scrolls = ZuiQueryBegin(ZUI_COMPONENT_BIT(ZUI_COMPONENT_SCROLL));
+        while (ZuiQueryNext(&scrolls))
+        {
+            const uint32_t itemId = scrolls.itemId;
+            ZuiScrollData *scroll = (ZuiScrollData *)scrolls.components[ZUI_COMPONENT_SCROLL];
 
-                Rectangle bounds = ZuiGetTransformBounds(i);
-                const ZuiLayoutData *layout = (const ZuiLayoutData *)ZuiItemGetComponent(i, ZUI_COMPONENT_LAYOUT);
-                float padding = layout ? layout->padding : 0.0F;
-                scroll->viewport = (Rectangle){
-                    bounds.x + padding,
-                    bounds.y + padding,
-                    bounds.width - (padding * 2.0F),
-                    bounds.height - (padding * 2.0F)};
-                scroll->contentSize = ZuiCalculateContentSize(i);
+            Rectangle bounds = ZuiGetTransformBounds(itemId);
+            const ZuiLayoutData *layout = (const ZuiLayoutData *)ZuiItemGetComponent(itemId, ZUI_COMPONENT_LAYOUT);
+            float padding = layout ? layout->padding : 0.0F;
+            scroll->viewport = (Rectangle){
+                bounds.x + padding,
+                bounds.y + padding,
+                bounds.width - (padding * 2.0F),
+                bounds.height - (padding * 2.0F)};
+            scroll->contentSize = ZuiCalculateContentSize(itemId);
 
-                bool inViewport = CheckCollisionPointRec(mousePos, scroll->viewport);
+            bool inViewport = CheckCollisionPointRec(mousePos, scroll->viewport);
 
-                if (!scroll->isDragging)
+            if (!scroll->isDragging)
+            {
+                if (scroll->verticalEnabled)
                 {
-                    if (scroll->verticalEnabled)
+                    Rectangle bar = ZuiScrollGetBarRect(scroll, true);
+                    if (bar.width > 0 && CheckCollisionPointRec(mousePos, bar) &&
+                        IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                     {
-                        Rectangle bar = ZuiScrollGetBarRect(scroll, true);
-                        if (bar.width > 0 && CheckCollisionPointRec(mousePos, bar) &&
-                            IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
-                        {
-                            scroll->isDragging = true;
-                            scroll->dragMode = ZUI_SCROLL_DRAG_VERTICAL;
-                            scroll->dragStart = mousePos;
-                        }
+                        scroll->isDragging = true;
+                        scroll->dragMode = ZUI_SCROLL_DRAG_VERTICAL;
+                        scroll->dragStart = mousePos;
                     }
+                }
 
-                    if (scroll->horizontalEnabled)
+                if (scroll->horizontalEnabled)
+                {
+                    Rectangle bar = ZuiScrollGetBarRect(scroll, false);
+                    if (bar.width > 0 && CheckCollisionPointRec(mousePos, bar) &&
+                        IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
                     {
-                        Rectangle bar = ZuiScrollGetBarRect(scroll, false);
-                        if (bar.width > 0 && CheckCollisionPointRec(mousePos, bar) &&
-                            IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
-                        {
-                            scroll->isDragging = true;
-                            scroll->dragMode = ZUI_SCROLL_DRAG_HORIZONTAL;
-                            scroll->dragStart = mousePos;
-                        }
+                        scroll->isDragging = true;
+                        scroll->dragMode = ZUI_SCROLL_DRAG_HORIZONTAL;
+                        scroll->dragStart = mousePos;
                     }
                 }
+            }
+
+            if (scroll->isDragging && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+            {
+                Vector2 delta = {
+                    mousePos.x - scroll->dragStart.x,
+                    mousePos.y - scroll->dragStart.y};
+                Vector2 max = ZuiScrollGetMaxOffset(scroll);
+
+                if (scroll->dragMode == ZUI_SCROLL_DRAG_VERTICAL && max.y > 0.0F)
+                {
+                    float ratio = scroll->viewport.height / scroll->contentSize.y;
+                    float thumbHeight = fmaxf(20.0F, scroll->viewport.height * ratio);
+                    float trackHeight = scroll->viewport.height - thumbHeight;
+                    scroll->targetOffset.y += (delta.y / trackHeight) * max.y;
+                }
+
+                if (scroll->dragMode == ZUI_SCROLL_DRAG_HORIZONTAL && max.x > 0.0F)
+                {
+                    float ratio = scroll->viewport.width / scroll->contentSize.x;
+                    float thumbWidth = fmaxf(20.0F, scroll->viewport.width * ratio);
+                    float trackWidth = scroll->viewport.width - thumbWidth;
+                    scroll->targetOffset.x += (delta.x / trackWidth) * max.x;
+                }
+
+                scroll->targetOffset = ZuiScrollClampOffset(scroll, scroll->targetOffset);
+                scroll->dragStart = mousePos;
+            }
+
+            if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
+            {
+                scroll->isDragging = false;
+                scroll->dragMode = ZUI_SCROLL_DRAG_NONE;
+            }
+
+            if (inViewport && !scroll->isDragging)
+            {
+                Vector2 wheelV = GetMouseWheelMoveV();
+                bool shiftDown = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
 
-                if (scroll->isDragging && IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+                float wheelAmountX = 0.0F;
+                float wheelAmountY = 0.0F;
+
+                if (scroll->verticalEnabled && !shiftDown)
                 {
-                    Vector2 delta = {
-                        mousePos.x - scroll->dragStart.x,
-                        mousePos.y - scroll->dragStart.y};
-                    Vector2 max = ZuiScrollGetMaxOffset(scroll);
+                    wheelAmountY = wheelV.y * 20.0F;
+                }
 
-                    if (scroll->dragMode == ZUI_SCROLL_DRAG_VERTICAL && max.y > 0.0F)
+                if (scroll->horizontalEnabled)
+                {
+                    if (shiftDown)
                     {
-                        float ratio = scroll->viewport.height / scroll->contentSize.y;
-                        float thumbHeight = fmaxf(20.0F, scroll->viewport.height * ratio);
-                        float trackHeight = scroll->viewport.height - thumbHeight;
-                        scroll->targetOffset.y += (delta.y / trackHeight) * max.y;
+                        wheelAmountX = wheelV.y * 20.0F;
                     }
-
-                    if (scroll->dragMode == ZUI_SCROLL_DRAG_HORIZONTAL && max.x > 0.0F)
+                    else if (wheelV.x != 0.0F)
                     {
-                        float ratio = scroll->viewport.width / scroll->contentSize.x;
-                        float thumbWidth = fmaxf(20.0F, scroll->viewport.width * ratio);
-                        float trackWidth = scroll->viewport.width - thumbWidth;
-                        scroll->targetOffset.x += (delta.x / trackWidth) * max.x;
+                        wheelAmountX = wheelV.x * 20.0F;
                     }
+                }
 
+                if (wheelAmountX != 0.0F || wheelAmountY != 0.0F)
+                {
+                    scroll->targetOffset.x -= wheelAmountX;
+                    scroll->targetOffset.y -= wheelAmountY;
                     scroll->targetOffset = ZuiScrollClampOffset(scroll, scroll->targetOffset);
-                    scroll->dragStart = mousePos;
                 }
+            }
+
+            const Vector2 previous = scroll->offset;
+            float lerpSpeed = 10.0F * deltaTime;
+            scroll->offset.x = ZuiLerp(scroll->offset.x, scroll->targetOffset.x, lerpSpeed);
+            scroll->offset.y = ZuiLerp(scroll->offset.y, scroll->targetOffset.y, lerpSpeed);
+            scroll->offset = ZuiScrollClampOffset(scroll, scroll->offset);
+            if (scroll->offset.x != previous.x || scroll->offset.y != previous.y)
+            {
+                ZuiInvalidateWorldBounds(itemId); // moves the descendants' world bounds
+            }
+        }
+
+        // Custom component systems, built-ins are handled above
+        for (uint32_t c = ZUI_COMPONENT_COUNT; c < g_zui_ctx->componentRegistry.registrations.count; c++)
+        {
+            const ZuiComponentRegistration *reg = ZuiGetComponentRegistration(c);
+            if (!reg->update)
+            {
+                continue;
+            }
 
-                if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
+            for (uint32_t dense = 0; dense < reg->dataArray.count && dense < reg->owners.count; dense++)
+            {
+                const uint32_t owner = ((const uint32_t *)reg->owners.items)[dense];
+                if (owner != ZUI_ID_INVALID)
                 {
-                    scroll->isDragging = false;
-                    scroll->dragMode = ZUI_SCROLL_DRAG_NONE;
+                    reg->update(ZuiPagedArrayAt(&reg->dataArray, dense), owner);
                 }
+            }
+        }
 
-                if (inViewport && !scroll->isDragging)
-                {
-                    Vector2 wheelV = GetMouseWheelMoveV();
-                    bool shiftDown = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+        ZuiEndIteration();
+    }
 
-                    float wheelAmountX = 0.0F;
-                    float wheelAmountY = 0.0F;
+    void *ZuiAllocFrame(const size_t size, const size_t alignment)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return NULL;
+        }
+        return ZuiAllocArena(&g_zui_ctx->frameArena, size, alignment);
+    }
 
-                    if (scroll->verticalEnabled && !shiftDown)
-                    {
-                        wheelAmountY = wheelV.y * 20.0F;
-                    }
+    ZuiArenaStats ZuiGetFrameArenaStats(void)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return (ZuiArenaStats){0};
+        }
+        return ZuiGetArenaStats(&g_zui_ctx->frameArena);
+    }
 
-                    if (scroll->horizontalEnabled)
-                    {
-                        if (shiftDown)
-                        {
-                            wheelAmountX = wheelV.y * 20.0F;
-                        }
-                        else if (wheelV.x != 0.0F)
-                        {
-                            wheelAmountX = wheelV.x * 20.0F;
-                        }
-                    }
+    ZuiResult ZuiBeginTransientScope(void)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return ZUI_ERROR_NULL_CONTEXT;
+        }
 
-                    if (wheelAmountX != 0.0F || wheelAmountY != 0.0F)
-                    {
-                        scroll->targetOffset.x -= wheelAmountX;
-                        scroll->targetOffset.y -= wheelAmountY;
-                        scroll->targetOffset = ZuiScrollClampOffset(scroll, scroll->targetOffset);
-                    }
-                }
+        ZuiTransientScope *scope = &g_zui_ctx->transient;
+        if (scope->active)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "Transient scopes do not nest");
+            return ZUI_ERROR_INVALID_STATE;
+        }
+
+        // The queue is drained on both edges, pre-scope layouts must not wait on entries the rollback drops
+        ZuiUpdateLayout();
+
+        *scope = (ZuiTransientScope){
+            .marker = ZuiArenaMark(&g_zui_arena),
+            .items = g_zui_ctx->items,
+            .freeItems = g_zui_ctx->freeItems,
+            .componentRegistry = g_zui_ctx->componentRegistry,
+            .typeRegistry = g_zui_ctx->typeRegistry,
+            .cursor = g_zui_ctx->cursor,
+            .strings = g_zui_ctx->strings,
+            .layoutQueue = g_zui_ctx->layoutQueue,
+            .walkStack = g_zui_ctx->walkStack,
+            .deferredRemovals = g_zui_ctx->deferredRemovals,
+            .worldLanes = g_zui_ctx->worldLanes,
+            .freeLow = g_zui_ctx->freeItems.count,
+            .active = true,
+        };
+
+        // Grown arrays keep their old blocks intact so the snapshot stays valid
+        g_zui_arena.recycleSuspended = true;
+        g_zui_ctx->strings.frozen = true;
+
+        // Registrations live in pages, so copy them out, the copies are released with the marker
+        const uint32_t componentCount = scope->componentRegistry.registrations.count;
+        const uint32_t typeCount = scope->typeRegistry.registrations.count;
+        scope->components = ZuiAllocArena(&g_zui_arena, sizeof(ZuiComponentRegistration) * componentCount,
+                                          ZUI_ALIGNOF(ZuiComponentRegistration));
+        scope->types = ZuiAllocArena(&g_zui_arena, sizeof(ZuiTypeRegistration) * typeCount,
+                                     ZUI_ALIGNOF(ZuiTypeRegistration));
+        if (!scope->components || !scope->types)
+        {
+            g_zui_arena.recycleSuspended = false;
+            g_zui_ctx->strings.frozen = false;
+            ZuiArenaRestore(&g_zui_arena, scope->marker);
+            *scope = (ZuiTransientScope){0};
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to snapshot registries");
+            return ZUI_ERROR_OUT_OF_MEMORY;
+        }
+        for (uint32_t i = 0; i < componentCount; i++)
+        {
+            scope->components[i] = *ZuiGetComponentRegistration(i);
+        }
+        for (uint32_t i = 0; i < typeCount; i++)
+        {
+            scope->types[i] = *ZuiGetTypeRegistration(i);
+        }
+        return ZUI_OK;
+    }
+
+    // Puts an array descriptor back, copying surviving elements home if it was relocated
+    static void ZuiRestoreDynArray(ZuiDynArray *array, const ZuiDynArray *snapshot)
+    {
+        if (array->items != snapshot->items && snapshot->items && snapshot->count > 0)
+        {
+            memcpy(snapshot->items, array->items, (size_t)snapshot->count * snapshot->itemSize); /* Flawfinder: ignore */
+        }
+        *array = *snapshot;
+    }
+
+    // Pages never move, so only the page table needs restoring, later pages die with the arena marker
+    static void ZuiRestorePagedArray(ZuiPagedArray *array, const ZuiPagedArray *snapshot)
+    {
+        ZuiRestoreDynArray(&array->pages, &snapshot->pages);
+        *array = *snapshot;
+    }
+
+    void ZuiEndTransientScope(void)
+    {
+        ZUI_ASSERT_CTX_RETURN();
+        ZuiTransientScope *scope = &g_zui_ctx->transient;
+        if (!scope->active)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_INVALID_STATE, "No transient scope is active");
+            return;
+        }
+
+        ZuiUpdateLayout();
+
+        // Ids handed out inside the scope must stay stale afterwards, so every slot it allocated is retired
+        // as a free slot keeping its last generation. Their state is saved before the rollback overwrites it
+        const ZuiArenaMarker frameMarker = ZuiArenaMark(&g_zui_ctx->frameArena);
+        const uint32_t createdCount = g_zui_ctx->items.count - scope->items.count;
+        const uint32_t reusedCount = scope->reusedItems.count;
+        uint32_t *retired = createdCount + reusedCount > 0
+                                ? ZUI_FRAME_ALLOC_ARRAY(uint32_t, (createdCount + (size_t)reusedCount * 2))
+                                : NULL;
+        if (!retired && createdCount + reusedCount > 0)
+        {
+            ZUI_REPORT_ERROR(ZUI_ERROR_OUT_OF_MEMORY, "Failed to retire %u scoped item slots",
+                             createdCount + reusedCount);
+        }
+        for (uint32_t i = 0; retired && i < createdCount; i++)
+        {
+            retired[i] = ZuiItemArrayGet(&g_zui_ctx->items, scope->items.count + i)->generation;
+        }
+        for (uint32_t i = 0; retired && i < reusedCount; i++)
+        {
+            const uint32_t index = ((const uint32_t *)scope->reusedItems.items)[i];
+            retired[createdCount + (i * 2)] = index;
+            retired[createdCount + (i * 2) + 1] = ZuiItemArrayGet(&g_zui_ctx->items, index)->generation;
+        }
+
+        ZuiRestoreDynArray(&g_zui_ctx->layoutQueue, &scope->layoutQueue);
+        ZuiRestoreDynArray(&g_zui_ctx->walkStack, &scope->walkStack);
+        ZuiRestoreDynArray(&g_zui_ctx->deferredRemovals, &scope->deferredRemovals);
+        // Lanes grown inside the scope die with the marker, and pre-scope bounds may have moved
+        g_zui_ctx->worldLanes = scope->worldLanes;
+        g_zui_ctx->worldLanes.rebuild = true;
+        ZuiRestoreDynArray(&g_zui_ctx->items, &scope->items);
+        ZuiRestoreDynArray(&g_zui_ctx->freeItems, &scope->freeItems);
+        g_zui_ctx->freeItems.count = scope->freeLow; // entries above were popped, the retired slots go back below
+
+        // Registrations added inside the scope are dropped with the registry count
+        for (uint32_t i = 0; i < scope->componentRegistry.registrations.count; i++)
+        {
+            ZuiComponentRegistration *reg = ZuiComponentRegistrationPageAt(&g_zui_ctx->componentRegistry.registrations, i);
+            ZuiRestorePagedArray(&reg->dataArray, &scope->components[i].dataArray);
+            ZuiRestoreDynArray(&reg->sparse, &scope->components[i].sparse);
+            ZuiRestoreDynArray(&reg->owners, &scope->components[i].owners);
+            *reg = scope->components[i];
+        }
+        ZuiRestorePagedArray(&g_zui_ctx->componentRegistry.registrations, &scope->componentRegistry.registrations);
+        g_zui_ctx->componentRegistry = scope->componentRegistry;
+
+        for (uint32_t i = 0; i < scope->typeRegistry.registrations.count; i++)
+        {
+            ZuiTypeRegistration *reg = ZuiTypeRegistrationPageAt(&g_zui_ctx->typeRegistry.registrations, i);
+            ZuiRestorePagedArray(&reg->dataArray, &scope->types[i].dataArray);
+            ZuiRestoreDynArray(&reg->freeSlots, &scope->types[i].freeSlots);
+            *reg = scope->types[i];
+        }
+        ZuiRestorePagedArray(&g_zui_ctx->typeRegistry.registrations, &scope->typeRegistry.registrations);
+        g_zui_ctx->typeRegistry = scope->typeRegistry;
+
+        const ZuiItem *entries = (const ZuiItem *)scope->journal.items;
+        for (uint32_t i = 0; i < scope->journal.count; i++)
+        {
+            ZuiItem *item = (ZuiItem *)ZuiGetDynArray(&g_zui_ctx->items, entries[i].id & ZUI_ID_INDEX_MASK);
+            if (item)
+            {
+                *item = entries[i];
+            }
+        }
+        for (uint32_t i = 0; retired && i < reusedCount; i++)
+        {
+            ZuiResetItemSlot(ZuiItemArrayGet(&g_zui_ctx->items, retired[createdCount + (i * 2)]),
+                             retired[createdCount + (i * 2) + 1]);
+        }
+        for (uint32_t i = 0; i < scope->journal.count; i++)
+        {
+            if (!ZuiIsItemAlive(entries[i].id))
+            {
+                continue; // a reused slot journaled as a scope item, retired above
+            }
+            ZuiInvalidateSubtree(entries[i].id); // world caches were resolved against the scope's links
+            ZuiInvalidateLayout(entries[i].id);  // and the flush above arranged children the rollback removed
+        }
+
+        g_zui_ctx->cursor = scope->cursor;
+
+        // The frozen pool only appended past older chains, so clearing its slots keeps them intact
+        ZuiStringPool *strings = &g_zui_ctx->strings;
+        ZuiRestoreDynArray(&strings->bytes, &scope->strings.bytes);
+        ZuiRestoreDynArray(&strings->entries, &scope->strings.entries);
+        *strings = scope->strings;
+        uint32_t *slots = (uint32_t *)strings->buckets.items;
+        for (uint32_t i = 0; i < strings->buckets.count; i++)
+        {
+            if (slots[i] > strings->entries.count && slots[i] != ZUI_STRING_TOMBSTONE)
+            {
+                slots[i] = ZUI_STRING_NONE;
+            }
+        }
+
+        ZuiFocusContext *focus = &g_zui_ctx->g_focusContext;
+        if (focus->currentFocus != UINT_MAX && !ZuiIsItemAlive(focus->currentFocus))
+        {
+            focus->currentFocus = UINT_MAX;
+        }
+        if (focus->rootFocus != UINT_MAX && !ZuiIsItemAlive(focus->rootFocus))
+        {
+            focus->rootFocus = UINT_MAX;
+        }
+
+        ZuiMenuContext *menu = &g_zui_ctx->g_menuContext;
+        uint32_t *menuIds[] = {&menu->activeMenuBar, &menu->activeMenu, &menu->hoveredItem, &menu->lastMenuItem,
+                               &g_zui_ctx->windowManager.focusedWindow};
+        for (uint32_t i = 0; i < sizeof(menuIds) / sizeof(menuIds[0]); i++)
+        {
+            if (*menuIds[i] != ZUI_ID_INVALID && !ZuiIsItemAlive(*menuIds[i]))
+            {
+                *menuIds[i] = ZUI_ID_INVALID;
+            }
+        }
 
-                float lerpSpeed = 10.0F * deltaTime;
-                scroll->offset.x = ZuiLerp(scroll->offset.x, scroll->targetOffset.x, lerpSpeed);
-                scroll->offset.y = ZuiLerp(scroll->offset.y, scroll->targetOffset.y, lerpSpeed);
-                scroll->offset = ZuiScrollClampOffset(scroll, scroll->offset);
+        const uint32_t createdBase = scope->items.count;
+        g_zui_arena.recycleSuspended = false;
+        ZuiArenaRestore(&g_zui_arena, scope->marker);
+        *scope = (ZuiTransientScope){0};
+
+        // Outside the scope again, so the free list and the slots past the snapshot can grow for real
+        for (uint32_t i = 0; retired && i < reusedCount; i++)
+        {
+            ZuiPushFreeIndex(&g_zui_ctx->freeItems, retired[createdCount + (i * 2)], "FreeItems");
+        }
+        for (uint32_t i = 0; retired && i < createdCount; i++)
+        {
+            ZuiItem *slot = ZuiItemArrayPush(&g_zui_ctx->items, &g_zui_arena);
+            if (!slot)
+            {
+                break;
             }
+            ZuiResetItemSlot(slot, retired[i]);
+            ZuiPushFreeIndex(&g_zui_ctx->freeItems, createdBase + i, "FreeItems");
         }
+        ZuiArenaRestore(&g_zui_ctx->frameArena, frameMarker);
+    }
+
+    bool ZuiInTransientScope(void)
+    {
+        return g_zui_ctx != NULL && g_zui_ctx->transient.active;
     }
 
     void ZuiUpdate(void)
     {
         ZUI_ASSERT_CTX_RETURN();
+        const double start = GetTime();
+        ZuiResetArena(&g_zui_ctx->frameArena);
+        ZuiUpdateLayout();
         ZuiUpdateComponents();
+        ZuiMarkDirty(g_zui_ctx->g_focusContext.currentFocus); // polls the keyboard
         const ZuiItem *root = ZuiGetItem(g_zui_ctx->cursor.rootItem);
         if (root)
         {
             ZuiUpdateItem(root);
         }
+        g_zui_ctx->frameStats.updateMs = (GetTime() - start) * 1000.0;
+        g_zui_ctx->frameStats.itemCount = g_zui_ctx->items.count - g_zui_ctx->freeItems.count;
     }
 
     void ZuiRender(void)
     {
         ZUI_ASSERT_CTX_RETURN();
+        const double start = GetTime();
         const ZuiItem *root = ZuiGetItem(g_zui_ctx->cursor.rootItem);
         if (root)
         {
             ZuiRenderItem(root);
         }
+        g_zui_ctx->frameStats.renderMs = (GetTime() - start) * 1000.0;
+    }
+
+    ZuiFrameStats ZuiGetFrameStats(void)
+    {
+        if (!ZuiEnsureContext(ZUI_ERROR_NULL_CONTEXT, "Global context is NULL"))
+        {
+            return (ZuiFrameStats){0};
+        }
+        return g_zui_ctx->frameStats;
     }
 
     void ZuiExit(void)
@@ -5374,9 +9274,20 @@ extern "C"
         {
 #ifdef ZUI_DEBUG
             ZuiArenaStats stats = ZuiGetArenaStats(&g_zui_arena);
-            TraceLog(LOG_INFO, "ZUI: Arena: %.2F%% used (%zu / %zu bytes)",
-                     (double)stats.usagePercent, stats.usedBytes, stats.totalCapacity);
+            TraceLog(LOG_INFO, "ZUI: Arena: %.2F%% used (%zu / %zu bytes, %zu reserved)",
+                     (double)stats.usagePercent, stats.usedBytes, stats.committedBytes, stats.reservedBytes);
+            TraceLog(LOG_INFO, "ZUI: Frame arena high water: %zu bytes", g_zui_ctx->frameArena.highWater);
+            TraceLog(LOG_INFO, "ZUI: String pool: %u strings, %u bytes",
+                     g_zui_ctx->strings.entries.count, g_zui_ctx->strings.bytes.count);
+            for (uint32_t i = 0; i < g_zui_arena.typeStatsCount; i++)
+            {
+                const ZuiArenaTypeStats *typeStats = &g_zui_arena.typeStats[i];
+                TraceLog(LOG_INFO, "ZUI: Arena %s: %zu released, %zu reclaimed, %zu wasted bytes",
+                         typeStats->typeName, typeStats->releasedBytes, typeStats->reclaimedBytes,
+                         typeStats->wastedBytes);
+            }
 #endif
+            ZuiUnloadArena(&g_zui_ctx->frameArena);
             ZuiUnloadArena(&g_zui_arena);
         }
 
@@ -5438,6 +9349,8 @@ extern "C"
         {
             transform->offset.x += x;
             transform->offset.y += y;
+            ZuiInvalidateTransform(transform);
+            ZuiMarkDirty(transform->itemId);
             g_zui_ctx->cursor.position.x += x;
             g_zui_ctx->cursor.position.y += y;
         }
@@ -5590,8 +9503,8 @@ extern "C"
     void ZuiUpdateButton(uint32_t dataIndex)
     {
         ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_BUTTON];
-        ZuiButtonData *buttonData = (ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
+        ZuiTypeRegistration *reg = ZuiGetTypeRegistration(ZUI_BUTTON);
+        ZuiButtonData *buttonData = ZuiButtonDataPageGet(&reg->dataArray, dataIndex);
         if (!buttonData || buttonData->itemId == ZUI_ID_INVALID)
         {
             return;
@@ -5687,13 +9600,14 @@ extern "C"
                     // Deselect others in group
                     for (uint32_t i = 0; i < reg->dataArray.count; i++)
                     {
-                        ZuiButtonData *otherButton = (ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, i);
+                        ZuiButtonData *otherButton = ZuiButtonDataPageAt(&reg->dataArray, i);
                         if (otherButton &&
                             otherButton->mode == ZUI_BUTTON_RADIO &&
                             otherButton->groupId == buttonData->groupId &&
                             otherButton->itemId != itemId)
                         {
                             otherButton->isToggled = false;
+                            ZuiMarkDirty(otherButton->itemId);
                         }
                     }
                     buttonData->isToggled = true;
@@ -5755,13 +9669,14 @@ extern "C"
                     {
                         for (uint32_t i = 0; i < reg->dataArray.count; i++)
                         {
-                            ZuiButtonData *otherButton = (ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, i);
+                            ZuiButtonData *otherButton = ZuiButtonDataPageAt(&reg->dataArray, i);
                             if (otherButton &&
                                 otherButton->mode == ZUI_BUTTON_RADIO &&
                                 otherButton->groupId == buttonData->groupId &&
                                 otherButton->itemId != itemId)
                             {
                                 otherButton->isToggled = false;
+                                ZuiMarkDirty(otherButton->itemId);
                             }
                         }
                         buttonData->isToggled = true;
@@ -5783,8 +9698,8 @@ extern "C"
     void ZuiRenderButton(uint32_t dataIndex)
     {
         ZUI_ASSERT_CTX_RETURN();
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_BUTTON];
-        const ZuiButtonData *buttonData = (const ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, dataIndex);
+        ZuiTypeRegistration *reg = ZuiGetTypeRegistration(ZUI_BUTTON);
+        const ZuiButtonData *buttonData = ZuiButtonDataPageGet(&reg->dataArray, dataIndex);
         if (!buttonData || buttonData->itemId == ZUI_ID_INVALID)
         {
             return;
@@ -5833,9 +9748,8 @@ extern "C"
         const ZuiItem *buttonItem = ZuiGetItem(itemId);
         if (buttonItem && buttonItem->isContainer)
         {
-            for (uint32_t i = 0; i < buttonItem->children.count; i++)
+            for (uint32_t childId = buttonItem->firstChild; childId != ZUI_ID_INVALID; childId = ZuiItemNextSibling(childId))
             {
-                uint32_t childId = ((uint32_t *)buttonItem->children.items)[i];
                 const ZuiItem *child = ZuiGetItem(childId);
                 if (child)
                 {
@@ -5872,32 +9786,12 @@ extern "C"
             return ZUI_ID_INVALID;
         }
 
-        // Get the button data to access its children
-        ZuiButtonData *buttonData = (ZuiButtonData *)ZuiGetTypedData(id);
-        if (!buttonData)
-        {
-            return ZUI_ID_INVALID;
-        }
-
-        // Calculate movement from origin to cursor position
-        Vector2 delta = g_zui_ctx->cursor.position;
-
-        // Move the button itself to cursor position
+        // Icon and label are placed relative to the button and follow it
         Rectangle buttonBounds = ZuiGetTransformBounds(id);
-        buttonBounds.x = delta.x;
-        buttonBounds.y = delta.y;
+        buttonBounds.x = g_zui_ctx->cursor.position.x;
+        buttonBounds.y = g_zui_ctx->cursor.position.y;
         ZuiSetTransformBounds(id, buttonBounds);
 
-        if (buttonData->iconId != ZUI_ID_INVALID)
-        {
-            ZuiSetTransformBoundsPosition(buttonData->iconId, delta);
-        }
-
-        if (buttonData->labelId != ZUI_ID_INVALID)
-        {
-            ZuiSetTransformBoundsPosition(buttonData->labelId, delta);
-        }
-
         // Add to frame and advance cursor
         ZuiItemAddChild(g_zui_ctx->cursor.activeFrame, id);
         ZuiAdvanceCursor(buttonBounds.width, buttonBounds.height);
@@ -5982,6 +9876,7 @@ extern "C"
             if (buttonData)
             {
                 buttonData->style.labelStyle.textColor = color;
+                ZuiMarkDirty(itemId);
             }
         }
     }
@@ -6002,6 +9897,7 @@ extern "C"
             if (buttonData)
             {
                 buttonData->mode = mode;
+                ZuiMarkDirty(itemId);
                 if (mode == ZUI_BUTTON_RADIO)
                 {
                     ZuiEnableFocus(buttonData->itemId);
@@ -6020,35 +9916,35 @@ extern "C"
             if (buttonData)
             {
                 buttonData->groupId = groupId;
+                ZuiMarkDirty(itemId);
             }
         }
     }
 
-    bool ZuiIsButtonToggled(uint32_t itemId)
+    // Released button slots are zeroed, so look the data up through the item instead of scanning
+    static ZuiButtonData *ZuiGetButtonData(uint32_t itemId)
     {
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_BUTTON];
-        for (uint32_t i = 0; i < reg->dataArray.count; i++)
+        const ZuiItem *item = ZuiGetItem(itemId);
+        if (!item || item->type != ZUI_BUTTON)
         {
-            const ZuiButtonData *button = (const ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, i);
-            if (button && button->itemId == itemId)
-            {
-                return button->isToggled;
-            }
+            return NULL;
         }
-        return false;
+        return (ZuiButtonData *)ZuiGetTypedData(itemId);
+    }
+
+    bool ZuiIsButtonToggled(uint32_t itemId)
+    {
+        const ZuiButtonData *button = ZuiGetButtonData(itemId);
+        return button && button->isToggled;
     }
 
     void ZuiButtonSetToggled(uint32_t itemId, bool toggled)
     {
-        ZuiTypeRegistration *reg = &g_zui_ctx->typeRegistry.registrations[ZUI_BUTTON];
-        for (uint32_t i = 0; i < reg->dataArray.count; i++)
+        ZuiButtonData *button = ZuiGetButtonData(itemId);
+        if (button)
         {
-            ZuiButtonData *button = (ZuiButtonData *)ZuiGetDynArray(&reg->dataArray, i);
-            if (button && button->itemId == itemId)
-            {
-                button->isToggled = toggled;
-                return;
-            }
+            button->isToggled = toggled;
+            ZuiMarkDirty(itemId);
         }
     }
     // -----------------------------------------------------------------------------